@@ -0,0 +1,37 @@
+import { getCatalogueEntries, getCatalogueManifest } from '@/lib/catalogueManifest';
+
+// Reads query parameters, so it cannot be prerendered
+export const dynamic = 'force-dynamic';
+
+/**
+ * GET /api/catalogue
+ * Without parameters: the versioned manifest, revalidated with its ETag
+ * With `shard` (and optionally `ids`, comma-separated): the entries themselves.
+ * Entry requests include the manifest version, so they can be cached for good.
+ */
+export async function GET(request: Request) {
+  const url = new URL(request.url);
+  const shard = url.searchParams.get('shard');
+
+  if (!shard) {
+    const manifest = getCatalogueManifest();
+    const etag = `"${manifest.version}"`;
+    if (request.headers.get('If-None-Match') === etag) {
+      return new Response(null, { status: 304, headers: { ETag: etag } });
+    }
+    return Response.json(manifest, {
+      headers: { ETag: etag, 'Cache-Control': 'no-cache' },
+    });
+  }
+
+  const versioned = url.searchParams.get('v') === getCatalogueManifest().version;
+  const cacheControl = versioned ? 'public, max-age=31536000, immutable' : 'no-cache';
+
+  const ids = url.searchParams.get('ids')?.split(',').filter(Boolean);
+  const entries = getCatalogueEntries(shard, ids);
+  if (!entries) {
+    return Response.json({ error: `Unknown catalogue shard "${shard}"` }, { status: 404 });
+  }
+
+  return Response.json(entries, { headers: { 'Cache-Control': cacheControl } });
+}
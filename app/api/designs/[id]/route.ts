@@ -0,0 +1,118 @@
+import type { MessageRole } from '@/types/chat';
+import type { DesignRecord } from '@/lib/designStore';
+import {
+  deleteDesignRecord,
+  designDeletedAt,
+  designOwner,
+  getDesignRecord,
+  missingSyncKey,
+  putDesignRecord,
+} from '@/lib/designRecords';
+
+export const dynamic = 'force-dynamic';
+
+// A 500-item design is a few kilobytes; the rest is chat
+const MAX_BODY_BYTES = 256 * 1024;
+
+const isNumber = (value: unknown): value is number => typeof value === 'number' && Number.isFinite(value);
+const isString = (value: unknown): value is string => typeof value === 'string';
+const ROLES: ReadonlySet<unknown> = new Set<MessageRole>(['user', 'assistant', 'system']);
+
+/**
+ * Checks the shape of an uploaded design, dropping malformed messages
+ * Returns null when the body is not a design at all
+ */
+function parseRecord(body: unknown, id: string): DesignRecord | null {
+  if (typeof body !== 'object' || body === null) return null;
+  const { name, savedAt, itemCount, delta, messages } = body as Partial<DesignRecord>;
+  if (!isString(name) || !isNumber(savedAt) || !isNumber(itemCount) || !isString(delta)) return null;
+  if (!Array.isArray(messages)) return null;
+
+  return {
+    id,
+    name,
+    savedAt,
+    itemCount,
+    delta,
+    messages: messages.filter(
+      message =>
+        typeof message === 'object' &&
+        message !== null &&
+        isString(message.id) &&
+        ROLES.has(message.role) &&
+        isString(message.content) &&
+        isNumber(message.timestamp)
+    ),
+  };
+}
+
+type Params = { params: Promise<{ id: string }> };
+
+/**
+ * GET /api/designs/[id]
+ * One of the caller's synced designs, delta in base64 (see lib/designStore.ts)
+ */
+export async function GET(request: Request, { params }: Params) {
+  const owner = designOwner(request);
+  if (!owner) return missingSyncKey();
+  const { id } = await params;
+  const record = getDesignRecord(owner, id);
+  if (!record) return Response.json({ error: `Unknown design "${id}"` }, { status: 404 });
+  return Response.json(record, { headers: { 'Cache-Control': 'no-store' } });
+}
+
+/**
+ * PUT /api/designs/[id]
+ * Stores or overwrites a design; an older copy never replaces a newer one,
+ * and a copy saved before the design was deleted does not bring it back
+ */
+export async function PUT(request: Request, { params }: Params) {
+  const owner = designOwner(request);
+  if (!owner) return missingSyncKey();
+  const { id } = await params;
+  const text = await request.text();
+  if (text.length > MAX_BODY_BYTES) {
+    return Response.json({ error: 'Design too large' }, { status: 413 });
+  }
+
+  let record: DesignRecord | null = null;
+  try {
+    record = parseRecord(JSON.parse(text), id);
+  } catch {
+    // Reported below
+  }
+  if (!record) {
+    return Response.json({ error: 'Expected a design' }, { status: 400 });
+  }
+
+  const existing = getDesignRecord(owner, id);
+  if (existing && existing.savedAt > record.savedAt) {
+    return Response.json({ error: 'A newer copy is stored' }, { status: 409 });
+  }
+  if ((designDeletedAt(owner, id) ?? -Infinity) >= record.savedAt) {
+    return Response.json({ error: 'The design was deleted' }, { status: 410 });
+  }
+  putDesignRecord(owner, record);
+  return new Response(null, { status: 204 });
+}
+
+/**
+ * DELETE /api/designs/[id]
+ * Body `{ deletedAt }` dates the tombstone; saves of the design from
+ * before then are refused. Without it the server's clock is used.
+ */
+export async function DELETE(request: Request, { params }: Params) {
+  const owner = designOwner(request);
+  if (!owner) return missingSyncKey();
+  const { id } = await params;
+
+  let deletedAt = Date.now();
+  try {
+    const body = JSON.parse(await request.text());
+    if (isNumber(body?.deletedAt)) deletedAt = body.deletedAt;
+  } catch {
+    // No body; keep the server's time
+  }
+  deleteDesignRecord(owner, id, deletedAt);
+  return new Response(null, { status: 204 });
+}
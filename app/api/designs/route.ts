@@ -0,0 +1,15 @@
+import { designOwner, listDesigns, missingSyncKey } from '@/lib/designRecords';
+
+// Designs are held in memory; nothing here can be prerendered
+export const dynamic = 'force-dynamic';
+
+/**
+ * GET /api/designs
+ * Summaries of the caller's synced designs, newest first, and tombstones
+ * of the ones deleted (see lib/designRecords.ts)
+ */
+export async function GET(request: Request) {
+  const owner = designOwner(request);
+  if (!owner) return missingSyncKey();
+  return Response.json(listDesigns(owner), { headers: { 'Cache-Control': 'no-store' } });
+}
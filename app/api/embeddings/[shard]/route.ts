@@ -0,0 +1,38 @@
+import { CATALOGUE_SHARDS, getCatalogueManifest } from '@/lib/catalogueManifest';
+import { BinaryCatalogue } from '@/lib/binaryCatalogue';
+import { EMBEDDING_SHARD_CONTENT_TYPE, encodeEmbeddingShard } from '@/lib/embeddingShards';
+import { readPrebuiltShard } from '@/lib/prebuiltEmbeddings';
+
+// Prerendered by `next build`: embedding happens at build time, never per request
+export const dynamic = 'force-static';
+export const dynamicParams = false;
+
+export function generateStaticParams() {
+  return Object.keys(CATALOGUE_SHARDS).map(shard => ({ shard }));
+}
+
+/**
+ * GET /api/embeddings/[shard]
+ * Quantized item embeddings for one catalogue shard (see lib/embeddingShards.ts).
+ * Clients add the shard version as `?v=`, which the service worker keys on
+ * to keep each version for good (see public/sw.js). The prerendered
+ * response is the same for every query, so HTTP caches must revalidate it.
+ */
+export async function GET(_request: Request, { params }: { params: Promise<{ shard: string }> }) {
+  const { shard } = await params;
+  const items = CATALOGUE_SHARDS[shard];
+  const shardManifest = getCatalogueManifest().shards.find(entry => entry.shard === shard);
+  if (!items || !shardManifest) {
+    return Response.json({ error: `Unknown catalogue shard "${shard}"` }, { status: 404 });
+  }
+
+  // The file written before the build, unless it is out of date
+  const prebuilt = readPrebuiltShard(shard, shardManifest.version, items.length);
+  const body = prebuilt?.buffer ?? encodeEmbeddingShard(BinaryCatalogue.fromItems(items), shardManifest.version);
+  return new Response(body, {
+    headers: {
+      'Content-Type': EMBEDDING_SHARD_CONTENT_TYPE,
+      'Cache-Control': 'public, max-age=0, must-revalidate',
+    },
+  });
+}
@@ -0,0 +1,109 @@
+import { MetricsReport, RETRIEVAL_STAGES, percentiles } from '@/lib/perfMetrics';
+import { RateLimiter, clientKey, tooManyRequests } from '@/lib/rateLimit';
+
+// Aggregates beacons in memory; nothing here can be prerendered
+export const dynamic = 'force-dynamic';
+
+// Most recent reports kept per server instance, for at most a day
+const MAX_REPORTS = 500;
+const REPORT_TTL_MS = 24 * 60 * 60 * 1000;
+const MAX_BODY_BYTES = 64 * 1024;
+
+// A page beacons on each hide, so a few per minute covers tab switching;
+// anything faster is not a browser reporting its own metrics
+const RATE_WINDOW_MS = 60 * 1000;
+const limiter = new RateLimiter({ limit: 10, windowMs: RATE_WINDOW_MS });
+
+const reports: { report: MetricsReport; receivedAt: number }[] = [];
+
+/**
+ * Drops reports older than REPORT_TTL_MS; they arrive in time order
+ */
+function pruneReports(now: number) {
+  const firstLive = reports.findIndex(entry => now - entry.receivedAt < REPORT_TTL_MS);
+  reports.splice(0, firstLive === -1 ? reports.length : firstLive);
+}
+
+const isNumber = (value: unknown): value is number => typeof value === 'number' && Number.isFinite(value);
+
+/**
+ * Checks the shape of a beacon body, dropping malformed retrieval samples
+ * Returns null when the body is not a report at all
+ */
+function parseReport(body: unknown): MetricsReport | null {
+  if (typeof body !== 'object' || body === null) return null;
+  const { frames, renderer, retrievals } = body as Partial<MetricsReport>;
+  if (!frames || !isNumber(frames.p50) || !isNumber(frames.p95) || !isNumber(frames.p99)) return null;
+  if (!renderer || !isNumber(renderer.drawCalls) || !isNumber(renderer.triangles)) return null;
+  if (!Array.isArray(retrievals)) return null;
+
+  return {
+    frames,
+    renderer,
+    retrievals: retrievals.filter(
+      sample => typeof sample === 'object' && sample !== null && isNumber(sample.total)
+    ),
+  };
+}
+
+/**
+ * POST /api/metrics
+ * Accepts one beacon from lib/perfMetrics.ts. sendBeacon posts text/plain,
+ * so the body is parsed as JSON text whatever its content type. Writes are
+ * rate-limited per client.
+ */
+export async function POST(request: Request) {
+  if (!limiter.allow(clientKey(request))) return tooManyRequests(RATE_WINDOW_MS);
+
+  const text = await request.text();
+  if (text.length > MAX_BODY_BYTES) {
+    return Response.json({ error: 'Report too large' }, { status: 413 });
+  }
+
+  let report: MetricsReport | null = null;
+  try {
+    report = parseReport(JSON.parse(text));
+  } catch {
+    // Reported below
+  }
+  if (!report) {
+    return Response.json({ error: 'Expected a metrics report' }, { status: 400 });
+  }
+
+  const now = Date.now();
+  pruneReports(now);
+  reports.push({ report, receivedAt: now });
+  if (reports.length > MAX_REPORTS) reports.splice(0, reports.length - MAX_REPORTS);
+  return new Response(null, { status: 204 });
+}
+
+/**
+ * GET /api/metrics
+ * Field percentiles across the reports of the last day
+ */
+export async function GET() {
+  pruneReports(Date.now());
+  const live = reports.map(entry => entry.report);
+  const samples = live.flatMap(report => report.retrievals);
+  const stages = Object.fromEntries(
+    [...RETRIEVAL_STAGES, 'total' as const].map(stage => [
+      stage,
+      percentiles(
+        samples.flatMap(sample => {
+          const value = sample[stage];
+          return isNumber(value) ? [value] : [];
+        })
+      ),
+    ])
+  );
+
+  return Response.json(
+    {
+      reports: live.length,
+      frameP95: percentiles(live.map(report => report.frames.p95)),
+      drawCalls: percentiles(live.map(report => report.renderer.drawCalls)),
+      retrieval: stages,
+    },
+    { headers: { 'Cache-Control': 'no-store' } }
+  );
+}
@@ -0,0 +1,123 @@
+import { Furniture } from '@/types/furniture';
+import { retrieveFurniture, retrieveFurnitureByCategory, classifyRoomStyle } from '@/lib/mockRAG';
+import { DEFAULT_LATENCY_BUDGET_MS, isAbortError, now } from '@/lib/retrievalBackend';
+import {
+  NDJSON_CONTENT_TYPE,
+  RetrievalEvent,
+  RetrieveRequestBody,
+  encodeRetrievalEvent,
+} from '@/lib/retrievalStream';
+
+// Catalogue and indexes stay on the server; this route streams ranked results
+export const dynamic = 'force-dynamic';
+
+const MAX_RESULTS_LIMIT = 200;
+const MAX_BUDGET_MS = 5000;
+
+interface ParsedRequest {
+  query: string;
+  maxResults: number;
+  categories?: string[];
+  budgetMs: number;
+}
+
+/**
+ * Validates the JSON body, filling in defaults
+ * Returns null when the body is not a usable request
+ */
+function parseRequestBody(body: unknown): ParsedRequest | null {
+  if (typeof body !== 'object' || body === null) return null;
+  const { query, maxResults, categories, budgetMs } = body as Partial<RetrieveRequestBody>;
+
+  if (typeof query !== 'string' || query.trim().length === 0) return null;
+  if (categories !== undefined &&
+      (!Array.isArray(categories) || !categories.every(c => typeof c === 'string'))) {
+    return null;
+  }
+
+  const clamp = (value: unknown, fallback: number, max: number) =>
+    typeof value === 'number' && Number.isFinite(value) && value > 0 ? Math.min(value, max) : fallback;
+
+  return {
+    query,
+    maxResults: Math.floor(clamp(maxResults, 10, MAX_RESULTS_LIMIT)),
+    categories,
+    budgetMs: clamp(budgetMs, DEFAULT_LATENCY_BUDGET_MS, MAX_BUDGET_MS),
+  };
+}
+
+/**
+ * POST /api/retrieve
+ * Streams ranked furniture as NDJSON (see lib/retrievalStream.ts)
+ */
+export async function POST(request: Request) {
+  let body: unknown;
+  try {
+    body = await request.json();
+  } catch {
+    return Response.json({ error: 'Request body must be JSON' }, { status: 400 });
+  }
+
+  const params = parseRequestBody(body);
+  if (!params) {
+    return Response.json({ error: 'Expected { query: string, maxResults?: number }' }, { status: 400 });
+  }
+
+  const { query, maxResults, categories, budgetMs } = params;
+  const signal = request.signal;
+
+  const stream = new ReadableStream<Uint8Array>({
+    async start(controller) {
+      let closed = false;
+      const send = (event: RetrievalEvent) => {
+        if (closed) return;
+        try {
+          controller.enqueue(encodeRetrievalEvent(event));
+        } catch {
+          closed = true; // Client went away; keep the retrieval from erroring
+        }
+      };
+
+      try {
+        // Classified once here; the retrieval reuses it
+        const classifyStart = now();
+        const classification = categories ? undefined : classifyRoomStyle(query);
+        const classifyTime = now() - classifyStart;
+        send({
+          type: 'meta',
+          query,
+          style: classification?.style,
+          styleScores: classification?.scores,
+        });
+
+        // Items are written as soon as their rank is final, while the
+        // re-ranker is still scoring the rest
+        const onItem = (furniture: Furniture, rank: number) => send({ type: 'item', rank, furniture });
+        const result = categories
+          ? await retrieveFurnitureByCategory(categories, { budgetMs, signal, onItem })
+          : await retrieveFurniture(query, maxResults, { budgetMs, signal, onItem }, classification);
+
+        send({
+          type: 'done',
+          timestamp: result.timestamp.toISOString(),
+          partial: result.partial ?? false,
+          timings: classification ? { ...result.timings, classify: classifyTime } : result.timings,
+        });
+      } catch (error) {
+        if (!isAbortError(error)) {
+          console.error('Error retrieving furniture:', error);
+          send({ type: 'error', message: 'Retrieval failed' });
+        }
+      } finally {
+        if (!closed) controller.close();
+      }
+    },
+  });
+
+  return new Response(stream, {
+    headers: {
+      'Content-Type': NDJSON_CONTENT_TYPE,
+      'Cache-Control': 'no-store',
+    },
+  });
+}
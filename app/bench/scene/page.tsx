@@ -0,0 +1,12 @@
+import { notFound } from 'next/navigation';
+import SceneBench from '@/components/SceneBench';
+
+/**
+ * GET /bench/scene
+ * Only served by `npm run dev`, or by production builds made with
+ * ENABLE_BENCH_ROUTES=1, so a normal deployment has no benchmark page
+ */
+export default function SceneBenchPage() {
+  if (process.env.NODE_ENV === 'production' && process.env.ENABLE_BENCH_ROUTES !== '1') notFound();
+  return <SceneBench />;
+}
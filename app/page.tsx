@@ -1,15 +1,30 @@
 'use client';
 
-import { useState } from 'react';
+import { useCallback, useEffect, useState } from 'react';
 import dynamic from 'next/dynamic';
-import { Furniture } from '@/types/furniture';
-import { ChatMessage } from '@/types/chat';
-import { retrieveFurniture, detectRoomStyle } from '@/lib/mockRAG';
+import { Furniture, RAGRetrievalResult } from '@/types/furniture';
+import { ChatMessage, RoomStyle } from '@/types/chat';
+import { isAbortError, normalizeQuery, requestKey } from '@/lib/retrievalBackend';
+import { streamFurniture } from '@/lib/retrievalStream';
+import { FurnitureStore, useFurnitureStats } from '@/lib/furnitureStore';
+import { appendToMessage, createTextChannel, finishMessage, pipeTextStream, writeWords } from '@/lib/chatStream';
+import { LatestRequestManager } from '@/lib/requestManager';
+import { ReconcileOptions } from '@/lib/furnitureDiff';
+import { layoutFurniture } from '@/lib/layoutClient';
+import { installMetricsBeacon, recordRetrieval } from '@/lib/perfMetrics';
+import { loadRoomViewer, prefetchViewerChunks } from '@/lib/viewerChunks';
+import { HDB_FLOOR_PLAN } from '@/lib/floorPlan';
+import { RoomStreamer, loadRoomFurniture } from '@/lib/roomStreamer';
+import { RetrievalPrefetcher } from '@/lib/prefetcher';
+import { loadDesign, saveDesign } from '@/lib/designStore';
 import FurniturePanel from '@/components/FurniturePanel';
-import ChatBox from '@/components/ChatBox';
+import ChatBox, { QUICK_PROMPTS } from '@/components/ChatBox';
+import PerfOverlay from '@/components/PerfOverlay';
+import DesignMenu from '@/components/DesignMenu';
 
 // Dynamically import RoomViewer to avoid SSR issues with Three.js
-const RoomViewer = dynamic(() => import('@/components/RoomViewer'), {
+// Its controls, grid and shadow chunks are prefetched while the user types
+const RoomViewer = dynamic(loadRoomViewer, {
   ssr: false,
   loading: () => (
     <div className="w-full h-full flex items-center justify-center bg-gradient-to-b from-gray-800 to-gray-900">
@@ -21,94 +36,294 @@ const RoomViewer = dynamic(() => import('@/components/RoomViewer'), {
   ),
 });
 
+/**
+ * Whether two results list the same items in the same order
+ */
+function sameItems(a: Furniture[], b: Furniture[]): boolean {
+  return a.length === b.length && a.every((item, i) => item.id === b[i].id);
+}
+
+/**
+ * Visible and total item counts over the viewer
+ */
+function FurnitureCount({ store }: { store: FurnitureStore }) {
+  const { visibleCount, totalCount } = useFurnitureStats(store);
+  if (totalCount === 0) return null;
+
+  return (
+    <div className="absolute top-4 right-4 bg-white/90 backdrop-blur-sm rounded-lg shadow-lg px-4 py-2">
+      <div className="text-sm text-gray-600">Showing</div>
+      <div className="text-2xl font-bold text-primary-600">
+        {visibleCount}/{totalCount}
+      </div>
+      <div className="text-xs text-gray-500">items</div>
+    </div>
+  );
+}
+
 /**
  * Main DecoPlan application page
- * Manages state for furniture retrieval and visualization
+ * Manages state for furniture retrieval and visualization. The page holds
+ * the chat but never subscribes to the furniture: the viewer, panel and
+ * counters each subscribe to the store themselves, so a large retrieval
+ * re-renders only them, at low priority, and the memoized chat box only
+ * re-renders for its own messages and loading state.
  */
 export default function HomePage() {
-  const [furniture, setFurniture] = useState<Furniture[]>([]);
+  // Furniture lives in a normalized store so toggles and bulk visibility
+  // changes are single updates
+  const [furnitureStore] = useState(() => new FurnitureStore());
   const [isLoading, setIsLoading] = useState(false);
   const [chatMessages, setChatMessages] = useState<ChatMessage[]>([]);
 
+  // Only the newest retrieval may update the UI; older ones are aborted
+  const [retrievals] = useState(() => new LatestRequestManager<RAGRetrievalResult>());
+  // Layouts solve in a worker; only the newest one is applied
+  const [layouts] = useState(() => new LatestRequestManager<Furniture[]>());
+
+  // The chat designs the living room; the flat's other rooms load their
+  // own furniture as the camera approaches them
+  const [roomStreamer] = useState(() => new RoomStreamer(HDB_FLOOR_PLAN.rooms.slice(1), loadRoomFurniture));
+  useEffect(() => () => roomStreamer.dispose(), [roomStreamer]);
+
+  // Warms results for the quick prompts while the browser is idle
+  const [prefetcher] = useState(() => new RetrievalPrefetcher((request, signal) => streamFurniture(request, { signal })));
+  useEffect(() => () => prefetcher.cancel(), [prefetcher]);
+
+  /**
+   * Queues the quick prompts other than the one just shown
+   */
+  const prefetchOtherStyles = useCallback((shown: string) => {
+    prefetcher.schedule(
+      QUICK_PROMPTS.filter(({ prompt }) => normalizeQuery(prompt) !== normalizeQuery(shown)).map(({ prompt }) => ({
+        query: prompt,
+        maxResults: 10,
+      }))
+    );
+  }, [prefetcher]);
+
+  // Field metrics go out on page hide when NEXT_PUBLIC_METRICS_ENDPOINT is set
+  useEffect(() => installMetricsBeacon(), []);
+
+  /**
+   * Lays items out in the room, then applies them to the store
+   * Items with the same ids share one solve
+   */
+  const placeFurniture = useCallback(async (items: Furniture[], options?: ReconcileOptions) => {
+    const outcome = await layouts.run(items.map(item => item.id).join(','), signal =>
+      layoutFurniture(items, { signal })
+    );
+    if (outcome.status === 'fulfilled') furnitureStore.replace(outcome.value, options);
+  }, [layouts, furnitureStore]);
+
+  /**
+   * Retrieves furniture from the server route through the request manager
+   * Identical concurrent queries share one retrieval; ranked items are
+   * placed in the viewer as they stream in. `onStyle` hears the server's
+   * style classification early; a caller that joined a shared retrieval
+   * only gets it on the result. With `progressive` off, nothing is placed
+   * until the result is complete, e.g. while an optimistic result is shown.
+   * When the route cannot be reached, the cached catalogue is searched in
+   * the browser instead.
+   */
+  const runRetrieval = useCallback((
+    query: string,
+    maxResults: number,
+    onStyle?: (style: RoomStyle) => void,
+    progressive = true
+  ) =>
+    retrievals.run(requestKey({ query, maxResults }), signal =>
+      streamFurniture({ query, maxResults }, {
+        signal,
+        onStyle,
+        // Keep the previous items until the full result set is known
+        onProgress: progressive
+          ? items => {
+              placeFurniture(items, { keepMissing: true }).catch(error =>
+                console.error('Error placing furniture:', error)
+              );
+            }
+          : undefined,
+      }).catch(error => {
+        // Offline or server error: search the locally cached shards instead
+        if (isAbortError(error)) throw error;
+        console.warn('Retrieval route unavailable, searching locally:', error);
+        // Loaded on demand; it pulls in the indexes and shard decoding
+        return import('@/lib/shardRetrieval').then(({ shardRetrievalBackend }) =>
+          shardRetrievalBackend.retrieve({ query, maxResults }, { signal })
+        );
+      })
+    ), [retrievals, placeFurniture]);
+
+  /**
+   * Lays out and applies a retrieval result, keeping objects for items that
+   * did not change so their meshes and list cards are left alone
+   * Records the retrieval's stage timings, from `startTime` to placement
+   */
+  const applyRetrievedFurniture = useCallback(async (result: RAGRetrievalResult, startTime: number) => {
+    const layoutStart = performance.now();
+    await placeFurniture(result.furniture);
+    const end = performance.now();
+    recordRetrieval({ ...result.timings, layout: end - layoutStart }, startTime, end - startTime);
+  }, [placeFurniture]);
+
   /**
    * Handles furniture retrieval from mock RAG system
    */
-  const handleRetrieveFurniture = async () => {
+  const handleRetrieveFurniture = useCallback(async () => {
+    const query = 'Modern HDB living room setup';
+    prefetcher.cancel();
     setIsLoading(true);
+    let superseded = false;
     try {
-      const result = await retrieveFurniture('Modern HDB living room setup', 10);
-      setFurniture(result.furniture);
+      const startTime = performance.now();
+      const outcome = await runRetrieval(query, 10);
+      if (outcome.status === 'superseded') {
+        superseded = true;
+        return;
+      }
+      await applyRetrievedFurniture(outcome.value, startTime);
+      prefetchOtherStyles(query);
     } catch (error) {
       console.error('Error retrieving furniture:', error);
     } finally {
-      setIsLoading(false);
+      if (!superseded) setIsLoading(false);
     }
-  };
+  }, [prefetcher, runRetrieval, applyRetrievedFurniture, prefetchOtherStyles]);
 
   /**
    * Handles chat messages from the chatbox
+   * The assistant reply streams in while retrieval is still running. A
+   * prefetched result is shown straight away and the reply written
+   * optimistically; the confirming retrieval then runs in the background
+   * and only changes the room if its results differ.
    */
-  const handleSendMessage = async (message: string) => {
-    // Add user message
+  const handleSendMessage = useCallback(async (message: string) => {
+    // Add user message and an empty assistant reply to stream into
     const userMessage: ChatMessage = {
       id: Date.now().toString(),
       role: 'user',
       content: message,
       timestamp: new Date(),
     };
-    setChatMessages(prev => [...prev, userMessage]);
+    const assistantId = (Date.now() + 1).toString();
+    const assistantMessage: ChatMessage = {
+      id: assistantId,
+      role: 'assistant',
+      content: '',
+      timestamp: new Date(),
+      streaming: true,
+    };
+    setChatMessages(prev => [...prev, userMessage, assistantMessage]);
 
-    // Start loading
-    setIsLoading(true);
+    const reply = createTextChannel();
+    const replyDone = pipeTextStream(reply.readable, text =>
+      setChatMessages(prev => appendToMessage(prev, assistantId, text))
+    );
+    // The route classifies the style once and reports it first thing
+    let introduced = false;
+    const introduce = (style: RoomStyle = 'modern') => {
+      if (introduced) return;
+      introduced = true;
+      writeWords(reply, `Designing a ${style} style living room... `);
+    };
+
+    const placedMessage = (count: number) =>
+      `I've placed ${count} furniture items in the 3D viewer for you to explore!`;
+
+    // Speculation yields to the real request
+    prefetcher.cancel();
+    const prefetched = prefetcher.take({ query: message, maxResults: 10 });
+
+    // Only a request with nothing to show yet blocks the input
+    if (!prefetched) setIsLoading(true);
+    let superseded = false;
 
     try {
-      // Detect style from message
-      const style = detectRoomStyle(message);
-
-      // Retrieve furniture based on query
-      const result = await retrieveFurniture(message, 10);
-      setFurniture(result.furniture);
-
-      // Add assistant response
-      const assistantMessage: ChatMessage = {
-        id: (Date.now() + 1).toString(),
-        role: 'assistant',
-        content: `I've generated a ${style} style living room with ${result.furniture.length} furniture items. The furniture has been placed in the 3D viewer for you to explore!`,
-        timestamp: new Date(),
-      };
-      setChatMessages(prev => [...prev, assistantMessage]);
+      const startTime = performance.now();
+      if (prefetched) {
+        introduce(prefetched.style);
+        await placeFurniture(prefetched.furniture);
+        writeWords(reply, placedMessage(prefetched.furniture.length));
+      }
+
+      // Retrieve furniture based on query; a newer prompt makes this one stale
+      const outcome = await runRetrieval(message, 10, introduce, !prefetched);
+      if (outcome.status === 'superseded') {
+        superseded = true;
+        if (!prefetched) writeWords(reply, 'Switched to your newer request.');
+        return;
+      }
+      const result = outcome.value;
+      introduce(result.style);
+      await applyRetrievedFurniture(result, startTime);
+
+      if (!prefetched) {
+        writeWords(reply, placedMessage(result.furniture.length));
+      } else if (!sameItems(prefetched.furniture, result.furniture)) {
+        writeWords(reply, ' Updated with the latest matches.');
+      }
+      prefetchOtherStyles(message);
     } catch (error) {
       console.error('Error retrieving furniture:', error);
-
-      // Add error message
-      const errorMessage: ChatMessage = {
-        id: (Date.now() + 1).toString(),
-        role: 'assistant',
-        content: 'Sorry, I encountered an error while generating the room. Please try again.',
-        timestamp: new Date(),
-      };
-      setChatMessages(prev => [...prev, errorMessage]);
+      // A prefetched room is already on screen; keep it
+      if (!prefetched) {
+        writeWords(reply, 'Sorry, I encountered an error while generating the room. Please try again.');
+      }
     } finally {
-      setIsLoading(false);
+      // The newest request owns the loading state
+      if (!superseded) setIsLoading(false);
+
+      reply.close();
+      replyDone.then(() => setChatMessages(prev => finishMessage(prev, assistantId)));
     }
-  };
+  }, [prefetcher, placeFurniture, runRetrieval, applyRetrievedFurniture, prefetchOtherStyles]);
+
+  /**
+   * Saves the living room and chat as a design
+   */
+  const handleSaveDesign = useCallback(
+    (name: string) => saveDesign(name, furnitureStore.getSnapshot(), chatMessages),
+    [furnitureStore, chatMessages]
+  );
+
+  /**
+   * Puts a saved design back: its furniture where it was saved, and its chat
+   * Retrievals and prefetches in flight are dropped so they cannot
+   * overwrite the restored room. Saved positions are applied as they are,
+   * without another layout pass.
+   */
+  const handleRestoreDesign = useCallback(async (id: string) => {
+    const design = await loadDesign(id);
+    if (!design) return false;
+    retrievals.cancelAll();
+    layouts.cancelAll();
+    prefetcher.cancel();
+    furnitureStore.replace(design.furniture);
+    setChatMessages(design.messages);
+    setIsLoading(false);
+    return true;
+  }, [retrievals, layouts, prefetcher, furnitureStore]);
 
   /**
    * Toggles visibility of a specific furniture item
    */
-  const handleToggleFurniture = (id: string) => {
-    setFurniture(prevFurniture =>
-      prevFurniture.map(item =>
-        item.id === id ? { ...item, visible: !item.visible } : item
-      )
-    );
-  };
+  const handleToggleFurniture = useCallback((id: string) => {
+    furnitureStore.toggle(id);
+  }, [furnitureStore]);
+
+  /**
+   * Shows or hides every furniture item in one update
+   */
+  const handleSetAllVisible = useCallback((visible: boolean) => {
+    furnitureStore.setAllVisible(visible);
+  }, [furnitureStore]);
 
   return (
     <main className="h-screen w-screen flex overflow-hidden">
       {/* 3D Viewer Section (70%) */}
       <div className="flex-1 relative">
-        <RoomViewer furniture={furniture} />
+        <RoomViewer store={furnitureStore} plan={HDB_FLOOR_PLAN} streamer={roomStreamer} />
 
         {/* Floating info badge */}
         <div className="absolute top-4 left-4 bg-white/90 backdrop-blur-sm rounded-lg shadow-lg p-3 max-w-xs">
@@ -129,28 +344,28 @@ export default function HomePage() {
               RAG Mock
             </span>
           </div>
+          <DesignMenu
+            onSave={handleSaveDesign}
+            onRestore={handleRestoreDesign}
+            store={furnitureStore}
+          />
         </div>
 
-        {/* Camera controls info */}
-        <div className="absolute bottom-4 left-4 bg-black/70 text-white rounded-lg p-3 text-xs backdrop-blur-sm">
-          <div className="font-semibold mb-2">Camera Controls:</div>
-          <div className="space-y-1">
-            <div><span className="text-primary-400">Left Click + Drag:</span> Rotate</div>
-            <div><span className="text-primary-400">Right Click + Drag:</span> Pan</div>
-            <div><span className="text-primary-400">Scroll:</span> Zoom</div>
+        {/* Camera controls info, with the performance overlay beside it */}
+        <div className="absolute bottom-4 left-4 flex items-end gap-2">
+          <div className="bg-black/70 text-white rounded-lg p-3 text-xs backdrop-blur-sm">
+            <div className="font-semibold mb-2">Camera Controls:</div>
+            <div className="space-y-1">
+              <div><span className="text-primary-400">Left Click + Drag:</span> Rotate</div>
+              <div><span className="text-primary-400">Right Click + Drag:</span> Pan</div>
+              <div><span className="text-primary-400">Scroll:</span> Zoom</div>
+            </div>
           </div>
+          <PerfOverlay />
         </div>
 
         {/* Item count indicator */}
-        {furniture.length > 0 && (
-          <div className="absolute top-4 right-4 bg-white/90 backdrop-blur-sm rounded-lg shadow-lg px-4 py-2">
-            <div className="text-sm text-gray-600">Showing</div>
-            <div className="text-2xl font-bold text-primary-600">
-              {furniture.filter(f => f.visible).length}/{furniture.length}
-            </div>
-            <div className="text-xs text-gray-500">items</div>
-          </div>
-        )}
+        <FurnitureCount store={furnitureStore} />
       </div>
 
       {/* Right Panel Section (30%) */}
@@ -161,14 +376,16 @@ export default function HomePage() {
             messages={chatMessages}
             onSendMessage={handleSendMessage}
             isLoading={isLoading}
+            onInputActivity={prefetchViewerChunks}
           />
         </div>
 
         {/* Furniture Panel - Lower half */}
         <div className="h-1/2 overflow-hidden">
           <FurniturePanel
-            furniture={furniture}
+            store={furnitureStore}
             onToggleFurniture={handleToggleFurniture}
+            onSetAllVisible={handleSetAllVisible}
             onRetrieveFurniture={handleRetrieveFurniture}
             isLoading={isLoading}
           />
@@ -0,0 +1,105 @@
+import { readFileSync, writeFileSync } from 'node:fs';
+import { percentiles } from '@/lib/perfMetrics';
+
+/**
+ * Benchmark runner with p95 regression thresholds
+ *
+ * Each case runs a few warm-up iterations, then times `iterations` calls.
+ * bench/thresholds.json records a baseline p95 per case; a run fails when a
+ * case's p95 is more than `tolerance` times its baseline. Pass `--update`
+ * to write the measured p95s back as the new baselines. Under CI (the `CI`
+ * environment variable is set) a case without a baseline fails too, so a
+ * new case cannot slip past the gate unmeasured.
+ */
+
+export interface BenchOptions {
+  warmup?: number;
+  iterations?: number;
+}
+
+export interface BenchResult {
+  name: string;
+  iterations: number;
+  p50: number;
+  p95: number;
+  p99: number;
+}
+
+interface Thresholds {
+  tolerance: number;
+  baselines: Record<string, { p95Ms: number }>;
+}
+
+export const THRESHOLDS_PATH = new URL('./thresholds.json', import.meta.url);
+
+const now = () => performance.now();
+
+/**
+ * Times `fn` and returns percentiles in milliseconds
+ */
+export async function bench(
+  name: string,
+  fn: (iteration: number) => unknown,
+  { warmup = 5, iterations = 50 }: BenchOptions = {}
+): Promise<BenchResult> {
+  for (let i = 0; i < warmup; i++) await fn(-1 - i);
+
+  const samples: number[] = [];
+  for (let i = 0; i < iterations; i++) {
+    const start = now();
+    await fn(i);
+    samples.push(now() - start);
+  }
+  const { p50, p95, p99 } = percentiles(samples);
+  return { name, iterations, p50, p95, p99 };
+}
+
+/**
+ * Fixed-width result line
+ */
+export function formatResult({ name, iterations, p50, p95, p99 }: BenchResult): string {
+  const ms = (value: number) => `${value.toFixed(3).padStart(10)} ms`;
+  return `${name.padEnd(36)} n=${String(iterations).padEnd(5)} p50 ${ms(p50)}  p95 ${ms(p95)}  p99 ${ms(p99)}`;
+}
+
+function readThresholds(): Thresholds {
+  return JSON.parse(readFileSync(THRESHOLDS_PATH, 'utf8'));
+}
+
+/**
+ * Compares results with the recorded baselines, or records them with
+ * `--update`; sets a failing exit code when any case regressed
+ */
+export function checkThresholds(results: BenchResult[], argv = process.argv, ci = Boolean(process.env.CI)) {
+  const thresholds = readThresholds();
+
+  if (argv.includes('--update')) {
+    results.forEach(result => {
+      thresholds.baselines[result.name] = { p95Ms: Number(result.p95.toFixed(3)) };
+    });
+    writeFileSync(THRESHOLDS_PATH, `${JSON.stringify(thresholds, null, 2)}\n`);
+    console.log(`Updated ${results.length} baselines`);
+    return;
+  }
+
+  const regressions = results.flatMap(result => {
+    const baseline = thresholds.baselines[result.name];
+    if (!baseline) {
+      if (ci) return [`${result.name}: no baseline; record one with --update`];
+      console.warn(`No baseline for ${result.name}; run with --update to record one`);
+      return [];
+    }
+    const limit = baseline.p95Ms * thresholds.tolerance;
+    return result.p95 > limit
+      ? [`${result.name}: p95 ${result.p95.toFixed(3)} ms over ${limit.toFixed(3)} ms (baseline ${baseline.p95Ms} ms)`]
+      : [];
+  });
+
+  if (regressions.length > 0) {
+    console.error(`\n${regressions.length} benchmark(s) failed the gate:`);
+    regressions.forEach(line => console.error(`  ${line}`));
+    process.exitCode = 1;
+  } else {
+    console.log(`\nAll ${results.length} benchmarks within ${thresholds.tolerance}x of baseline p95`);
+  }
+}
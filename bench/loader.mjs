@@ -0,0 +1,65 @@
+/**
+ * Node module hooks that let benchmarks and build scripts import the app's
+ * TypeScript directly
+ *
+ * Resolves the `@/` path alias and extensionless relative imports the way
+ * the Next.js bundler does, and strips types with the SWC build that ships
+ * with Next, so neither needs extra dependencies.
+ */
+import { existsSync, statSync } from 'node:fs';
+import { readFile } from 'node:fs/promises';
+import { createRequire } from 'node:module';
+import { dirname, resolve as resolvePath } from 'node:path';
+import { fileURLToPath, pathToFileURL } from 'node:url';
+
+const root = resolvePath(dirname(fileURLToPath(import.meta.url)), '..');
+const require = createRequire(import.meta.url);
+const { transform } = require('next/dist/build/swc/index.js');
+
+const EXTENSIONS = ['.ts', '.tsx', '.js', '.mjs'];
+const TYPESCRIPT = /\.tsx?$/;
+
+function isFile(path) {
+  return existsSync(path) && statSync(path).isFile();
+}
+
+function findSource(base) {
+  if (isFile(base)) return base;
+  for (const extension of EXTENSIONS) {
+    if (isFile(base + extension)) return base + extension;
+  }
+  for (const extension of EXTENSIONS) {
+    const index = resolvePath(base, `index${extension}`);
+    if (isFile(index)) return index;
+  }
+  return null;
+}
+
+export async function resolve(specifier, context, nextResolve) {
+  let base = null;
+  if (specifier.startsWith('@/')) {
+    base = resolvePath(root, specifier.slice(2));
+  } else if ((specifier.startsWith('./') || specifier.startsWith('../')) && context.parentURL?.startsWith('file:')) {
+    base = resolvePath(dirname(fileURLToPath(context.parentURL)), specifier);
+  }
+  const source = base && findSource(base);
+  if (source) return { url: pathToFileURL(source).href, shortCircuit: true };
+  return nextResolve(specifier, context);
+}
+
+export async function load(url, context, nextLoad) {
+  if (!url.startsWith('file:') || !TYPESCRIPT.test(url)) return nextLoad(url, context);
+
+  const filename = fileURLToPath(url);
+  const { code } = await transform(await readFile(filename, 'utf8'), {
+    filename,
+    sourceMaps: 'inline',
+    jsc: {
+      parser: { syntax: 'typescript', tsx: filename.endsWith('.tsx') },
+      transform: { react: { runtime: 'automatic' } },
+      target: 'es2022',
+    },
+    module: { type: 'es6' },
+  });
+  return { format: 'module', source: code, shortCircuit: true };
+}
@@ -0,0 +1,100 @@
+import { BinaryCatalogue } from '@/lib/binaryCatalogue';
+import { decodeDesign, encodeDesign } from '@/lib/designCodec';
+import { buildCatalogueIndex } from '@/lib/hybridSearch';
+import {
+  calculateRoomCoverage,
+  createCatalogueBackend,
+  detectRoomStyle,
+  retrieveFurniture,
+  setRetrievalBackend,
+} from '@/lib/mockRAG';
+import { ROOM_DEPTH, ROOM_WIDTH } from '@/lib/roomStats';
+import { createSyntheticCatalogue, createSyntheticQueries } from '@/lib/syntheticCatalogue';
+import { Furniture } from '@/types/furniture';
+import { BenchResult, bench, checkThresholds, formatResult } from './harness';
+
+/**
+ * Microbenchmarks for retrieval, room coverage, style detection and
+ * design restore
+ *
+ *   npm run bench                      1k, 10k and 100k item catalogues
+ *   BENCH_SIZES=1000000 npm run bench  any list of sizes, e.g. 1M
+ *
+ * Index builds are setup and are not timed. Every retrieval uses a fresh
+ * query so the result cache never answers, and a generous budget so the
+ * timing covers the whole search rather than the deadline.
+ */
+
+const DEFAULT_SIZES = [1_000, 10_000, 100_000];
+// Coverage is a sweep over every footprint edge, O(n² log n); a room never
+// holds more than a few hundred items, so larger sizes only measure the sweep
+const MAX_COVERAGE_ITEMS = 10_000;
+const RETRIEVAL_BUDGET_MS = 60_000;
+// Retrieval p95 is dominated by JIT warm-up for the first few dozen queries
+const RETRIEVAL_RUNS = { warmup: 50, iterations: 200 };
+// A large saved design; restoring it decodes every item against the catalogue
+const DESIGN_ITEMS = 500;
+
+const sizes = process.env.BENCH_SIZES
+  ? process.env.BENCH_SIZES.split(',').map(Number).filter(size => size > 0)
+  : DEFAULT_SIZES;
+
+const label = (size: number) => (size >= 1_000_000 ? `${size / 1_000_000}M` : `${size / 1_000}k`);
+
+async function main() {
+  const results: BenchResult[] = [];
+  const report = (result: BenchResult) => {
+    console.log(formatResult(result));
+    results.push(result);
+  };
+
+  const queries = createSyntheticQueries(1_000);
+  report(await bench('detectRoomStyle', i => detectRoomStyle(queries[Math.max(i, 0) % queries.length]), {
+    iterations: 1_000,
+  }));
+
+  // Every other item moved by the layout, as after a real placement
+  const designItems = createSyntheticCatalogue(DESIGN_ITEMS);
+  const baseline = new Map(designItems.map(item => [item.id, item]));
+  const design = encodeDesign(
+    designItems.map((item, i) => ({
+      ...item,
+      position: i % 2 === 0 ? { ...item.position, x: item.position.x + 0.5 } : item.position,
+      visible: true,
+    })),
+    id => baseline.get(id)
+  );
+  report(await bench(`decodeDesign/${DESIGN_ITEMS}`, () => decodeDesign(design, id => baseline.get(id)), {
+    warmup: 50,
+    iterations: 500,
+  }));
+
+  for (const size of sizes) {
+    const items = createSyntheticCatalogue(size);
+
+    const buildStart = performance.now();
+    const catalogueIndex = buildCatalogueIndex(BinaryCatalogue.fromItems(items));
+    console.log(`  (indexed ${label(size)} items in ${(performance.now() - buildStart).toFixed(0)} ms)`);
+    setRetrievalBackend(createCatalogueBackend(() => catalogueIndex));
+
+    let queryId = 0;
+    report(await bench(`retrieveFurniture/${label(size)}`, () =>
+      retrieveFurniture(`${queries[queryId % queries.length]} v${queryId++}`, 10, { budgetMs: RETRIEVAL_BUDGET_MS }),
+      RETRIEVAL_RUNS
+    ));
+
+    if (size <= MAX_COVERAGE_ITEMS) {
+      const furniture: Furniture[] = items.map(item => ({ ...item, visible: true }));
+      report(await bench(`calculateRoomCoverage/${label(size)}`, () =>
+        calculateRoomCoverage(furniture, ROOM_WIDTH, ROOM_DEPTH), { warmup: 2, iterations: 20 }
+      ));
+    }
+  }
+
+  checkThresholds(results);
+}
+
+main().catch(error => {
+  console.error(error);
+  process.exit(1);
+});
@@ -0,0 +1,8 @@
+/**
+ * Registers the TypeScript loader for benchmark runs
+ *
+ *   node --import ./bench/register.mjs bench/micro.bench.ts
+ */
+import { register } from 'node:module';
+
+register('./loader.mjs', import.meta.url);
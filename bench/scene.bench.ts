@@ -0,0 +1,130 @@
+import { spawn } from 'node:child_process';
+import { mkdtempSync, rmSync } from 'node:fs';
+import { createServer } from 'node:http';
+import { AddressInfo } from 'node:net';
+import { tmpdir } from 'node:os';
+import { join } from 'node:path';
+import { BenchResult, checkThresholds, formatResult } from './harness';
+
+/**
+ * Headless WebGL benchmark for RoomViewer frame time
+ *
+ *   npm run dev   (or ENABLE_BENCH_ROUTES=1 npm run build && npm start)
+ *   npm run bench:scene
+ *
+ * Opens /bench/scene in headless Chrome once per scene size and waits for
+ * the page to POST the percentiles of its CPU render time per frame back
+ * to a local server.
+ * Chrome renders through SwiftShader, so absolute numbers are far slower
+ * than a GPU; they are comparable run to run on the same machine.
+ *
+ *   BENCH_BASE_URL  app origin, default http://localhost:3000
+ *   CHROME_PATH     Chrome or Chromium binary, default google-chrome
+ */
+
+const SCENE_SIZES = [10, 100, 1000];
+const BASE_URL = process.env.BENCH_BASE_URL ?? 'http://localhost:3000';
+const CHROME_PATH = process.env.CHROME_PATH ?? 'google-chrome';
+const RUN_TIMEOUT_MS = 60_000;
+
+interface SceneReport {
+  items: number;
+  frames: number;
+  p50: number;
+  p95: number;
+  p99: number;
+  drawCalls: number;
+  triangles: number;
+}
+
+type ReportListener = (report: SceneReport) => void;
+
+/**
+ * Local endpoint the bench page reports to
+ */
+function startReportServer(onReport: ReportListener) {
+  const server = createServer((request, response) => {
+    let body = '';
+    request.on('data', chunk => (body += chunk));
+    request.on('end', () => {
+      response.writeHead(204, { 'Access-Control-Allow-Origin': '*' }).end();
+      if (request.method !== 'POST') return;
+      try {
+        onReport(JSON.parse(body));
+      } catch {
+        console.warn('Ignoring malformed scene report');
+      }
+    });
+  });
+  return new Promise<{ url: string; close: () => void }>(resolve => {
+    server.listen(0, '127.0.0.1', () => {
+      const { port } = server.address() as AddressInfo;
+      resolve({ url: `http://127.0.0.1:${port}/report`, close: () => server.close() });
+    });
+  });
+}
+
+/**
+ * Runs the scene at one size in a fresh headless Chrome
+ */
+function runScene(items: number, reportUrl: string, waitForReport: (listener: ReportListener) => void) {
+  const profile = mkdtempSync(join(tmpdir(), 'decoplan-bench-'));
+  const url = `${BASE_URL}/bench/scene?items=${items}&report=${encodeURIComponent(reportUrl)}`;
+  const chrome = spawn(CHROME_PATH, [
+    '--headless=new',
+    '--no-first-run',
+    '--no-default-browser-check',
+    '--use-angle=swiftshader',
+    '--enable-unsafe-swiftshader',
+    '--window-size=1280,720',
+    `--user-data-dir=${profile}`,
+    url,
+  ], { stdio: 'ignore' });
+
+  const cleanUp = () => {
+    chrome.kill();
+    rmSync(profile, { recursive: true, force: true });
+  };
+
+  return new Promise<SceneReport>((resolve, reject) => {
+    const timer = setTimeout(() => {
+      cleanUp();
+      reject(new Error(`No report for ${items} items within ${RUN_TIMEOUT_MS} ms; is the app running at ${BASE_URL}?`));
+    }, RUN_TIMEOUT_MS);
+    chrome.on('error', error => {
+      clearTimeout(timer);
+      cleanUp();
+      reject(error);
+    });
+    waitForReport(report => {
+      if (report.items !== items) return;
+      clearTimeout(timer);
+      cleanUp();
+      resolve(report);
+    });
+  });
+}
+
+async function main() {
+  let listener: ReportListener = () => {};
+  const server = await startReportServer(report => listener(report));
+  const results: BenchResult[] = [];
+
+  try {
+    for (const items of SCENE_SIZES) {
+      const report = await runScene(items, server.url, next => (listener = next));
+      const result = { name: `RoomViewer/${items}`, iterations: report.frames, ...report };
+      console.log(`${formatResult(result)}  draws ${report.drawCalls}  tris ${report.triangles}`);
+      results.push(result);
+    }
+  } finally {
+    server.close();
+  }
+
+  checkThresholds(results);
+}
+
+main().catch(error => {
+  console.error(error);
+  process.exit(1);
+});
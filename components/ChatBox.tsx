@@ -1,27 +1,118 @@
 'use client';
 
-import { useState, useRef, useEffect } from 'react';
+import { memo, useState, useRef, useEffect } from 'react';
 import { ChatMessage } from '@/types/chat';
 
+/**
+ * Prompts offered before the chat starts, and as shortcuts once it has
+ * The page prefetches the shortcuts it expects the user to try next
+ */
+export const STARTER_PROMPTS = [
+  { label: 'Japanese style living room', prompt: 'Generate a Japanese style living room' },
+  { label: 'Modern minimalist room', prompt: 'Generate a modern minimalist room' },
+  { label: 'Traditional HDB furniture', prompt: 'Show me traditional HDB furniture' },
+];
+
+export const QUICK_PROMPTS = [
+  { label: 'Japanese', prompt: 'Generate a Japanese style living room' },
+  { label: 'Modern', prompt: 'Generate a modern room' },
+  { label: 'Minimalist', prompt: 'Generate a minimalist room' },
+];
+
 interface ChatBoxProps {
   messages: ChatMessage[];
   onSendMessage: (message: string) => void;
   isLoading: boolean;
+  onInputActivity?: () => void; // First focus or keystroke in the prompt input
 }
 
+/**
+ * Single chat message bubble
+ * Memoized so that streaming into one message leaves the other rows alone
+ */
+const MessageRow = memo(function MessageRow({ message }: { message: ChatMessage }) {
+  return (
+    <div
+      className={`flex ${
+        message.role === 'user' ? 'justify-end' : 'justify-start'
+      }`}
+    >
+      <div
+        className={`max-w-[80%] rounded-lg px-4 py-2 ${
+          message.role === 'user'
+            ? 'bg-purple-600 text-white'
+            : message.role === 'system'
+            ? 'bg-blue-50 text-blue-900 border border-blue-200'
+            : 'bg-gray-100 text-gray-900'
+        }`}
+      >
+        {message.role === 'assistant' && (
+          <div className="flex items-center gap-2 mb-1">
+            <svg
+              className="w-4 h-4 text-purple-600"
+              fill="currentColor"
+              viewBox="0 0 20 20"
+            >
+              <path
+                fillRule="evenodd"
+                d="M10 18a8 8 0 100-16 8 8 0 000 16zm1-11a1 1 0 10-2 0v2H7a1 1 0 100 2h2v2a1 1 0 102 0v-2h2a1 1 0 100-2h-2V7z"
+                clipRule="evenodd"
+              />
+            </svg>
+            <span className="text-xs font-semibold text-purple-600">
+              AI Assistant
+            </span>
+          </div>
+        )}
+        <p className="text-sm whitespace-pre-wrap">
+          {message.content}
+          {message.streaming && (
+            <span className="inline-block w-1.5 h-3.5 ml-0.5 align-middle bg-gray-400 animate-pulse" />
+          )}
+        </p>
+        <p
+          className={`text-xs mt-1 ${
+            message.role === 'user'
+              ? 'text-purple-200'
+              : 'text-gray-500'
+          }`}
+        >
+          {new Date(message.timestamp).toLocaleTimeString([], {
+            hour: '2-digit',
+            minute: '2-digit',
+          })}
+        </p>
+      </div>
+    </div>
+  );
+});
+
 /**
  * ChatBox component for user interaction
- * Allows users to request specific room styles and furniture
+ * Allows users to request specific room styles and furniture. The input
+ * is local state and the box is memoized, so keystrokes render only here
+ * and scene updates do not render it at all.
  */
-export default function ChatBox({ messages, onSendMessage, isLoading }: ChatBoxProps) {
+function ChatBox({ messages, onSendMessage, isLoading, onInputActivity }: ChatBoxProps) {
   const [input, setInput] = useState('');
   const messagesEndRef = useRef<HTMLDivElement>(null);
 
+  const lastMessage = messages[messages.length - 1];
+
   // Auto-scroll to bottom when new messages arrive
   useEffect(() => {
     messagesEndRef.current?.scrollIntoView({ behavior: 'smooth' });
-  }, [messages]);
+  }, [messages.length]);
 
+  // Keep a streaming reply in view without restarting the smooth scroll per chunk
+  useEffect(() => {
+    if (lastMessage?.streaming) {
+      messagesEndRef.current?.scrollIntoView({ block: 'end' });
+    }
+  }, [lastMessage?.content, lastMessage?.streaming]);
+
+  // The input stays editable while a room loads, so the next prompt can be
+  // typed; only sending waits for the current one
   const handleSubmit = (e: React.FormEvent) => {
     e.preventDefault();
     if (input.trim() && !isLoading) {
@@ -30,10 +121,10 @@ export default function ChatBox({ messages, onSendMessage, isLoading }: ChatBoxP
     }
   };
 
+  // Quick prompts stay usable while loading: a newer prompt supersedes the
+  // in-flight retrieval instead of racing it
   const handleQuickPrompt = (prompt: string) => {
-    if (!isLoading) {
-      onSendMessage(prompt);
-    }
+    onSendMessage(prompt);
   };
 
   return (
@@ -73,81 +164,22 @@ export default function ChatBox({ messages, onSendMessage, isLoading }: ChatBoxP
             <div className="space-y-2">
               <p className="text-xs text-gray-400 font-medium">Try these:</p>
               <div className="flex flex-col gap-2">
-                <button
-                  onClick={() => handleQuickPrompt('Generate a Japanese style living room')}
-                  disabled={isLoading}
-                  className="px-3 py-2 bg-purple-50 hover:bg-purple-100 text-purple-700 rounded-lg text-xs transition-colors disabled:opacity-50"
-                >
-                  Japanese style living room
-                </button>
-                <button
-                  onClick={() => handleQuickPrompt('Generate a modern minimalist room')}
-                  disabled={isLoading}
-                  className="px-3 py-2 bg-purple-50 hover:bg-purple-100 text-purple-700 rounded-lg text-xs transition-colors disabled:opacity-50"
-                >
-                  Modern minimalist room
-                </button>
-                <button
-                  onClick={() => handleQuickPrompt('Show me traditional HDB furniture')}
-                  disabled={isLoading}
-                  className="px-3 py-2 bg-purple-50 hover:bg-purple-100 text-purple-700 rounded-lg text-xs transition-colors disabled:opacity-50"
-                >
-                  Traditional HDB furniture
-                </button>
+                {STARTER_PROMPTS.map(({ label, prompt }) => (
+                  <button
+                    key={prompt}
+                    onClick={() => handleQuickPrompt(prompt)}
+                    className="px-3 py-2 bg-purple-50 hover:bg-purple-100 text-purple-700 rounded-lg text-xs transition-colors"
+                  >
+                    {label}
+                  </button>
+                ))}
               </div>
             </div>
           </div>
         ) : (
           <>
-            {messages.map((message) => (
-              <div
-                key={message.id}
-                className={`flex ${
-                  message.role === 'user' ? 'justify-end' : 'justify-start'
-                }`}
-              >
-                <div
-                  className={`max-w-[80%] rounded-lg px-4 py-2 ${
-                    message.role === 'user'
-                      ? 'bg-purple-600 text-white'
-                      : message.role === 'system'
-                      ? 'bg-blue-50 text-blue-900 border border-blue-200'
-                      : 'bg-gray-100 text-gray-900'
-                  }`}
-                >
-                  {message.role === 'assistant' && (
-                    <div className="flex items-center gap-2 mb-1">
-                      <svg
-                        className="w-4 h-4 text-purple-600"
-                        fill="currentColor"
-                        viewBox="0 0 20 20"
-                      >
-                        <path
-                          fillRule="evenodd"
-                          d="M10 18a8 8 0 100-16 8 8 0 000 16zm1-11a1 1 0 10-2 0v2H7a1 1 0 100 2h2v2a1 1 0 102 0v-2h2a1 1 0 100-2h-2V7z"
-                          clipRule="evenodd"
-                        />
-                      </svg>
-                      <span className="text-xs font-semibold text-purple-600">
-                        AI Assistant
-                      </span>
-                    </div>
-                  )}
-                  <p className="text-sm whitespace-pre-wrap">{message.content}</p>
-                  <p
-                    className={`text-xs mt-1 ${
-                      message.role === 'user'
-                        ? 'text-purple-200'
-                        : 'text-gray-500'
-                    }`}
-                  >
-                    {new Date(message.timestamp).toLocaleTimeString([], {
-                      hour: '2-digit',
-                      minute: '2-digit',
-                    })}
-                  </p>
-                </div>
-              </div>
+            {messages.map(message => (
+              <MessageRow key={message.id} message={message} />
             ))}
             <div ref={messagesEndRef} />
           </>
@@ -160,10 +192,13 @@ export default function ChatBox({ messages, onSendMessage, isLoading }: ChatBoxP
           <input
             type="text"
             value={input}
-            onChange={(e) => setInput(e.target.value)}
+            onChange={(e) => {
+              setInput(e.target.value);
+              onInputActivity?.();
+            }}
+            onFocus={onInputActivity}
             placeholder="Ask for a room style (e.g., Japanese living room)..."
-            disabled={isLoading}
-            className="flex-1 px-3 py-2 border border-gray-300 rounded-lg text-sm focus:outline-none focus:ring-2 focus:ring-purple-500 focus:border-transparent disabled:bg-gray-100 disabled:cursor-not-allowed"
+            className="flex-1 px-3 py-2 border border-gray-300 rounded-lg text-sm focus:outline-none focus:ring-2 focus:ring-purple-500 focus:border-transparent"
           />
           <button
             type="submit"
@@ -199,33 +234,21 @@ export default function ChatBox({ messages, onSendMessage, isLoading }: ChatBoxP
         {/* Quick action buttons when chat has started */}
         {messages.length > 0 && (
           <div className="mt-2 flex gap-2 flex-wrap">
-            <button
-              type="button"
-              onClick={() => handleQuickPrompt('Generate a Japanese style living room')}
-              disabled={isLoading}
-              className="px-2 py-1 bg-white hover:bg-gray-50 border border-gray-300 text-gray-700 rounded text-xs transition-colors disabled:opacity-50"
-            >
-              Japanese
-            </button>
-            <button
-              type="button"
-              onClick={() => handleQuickPrompt('Generate a modern room')}
-              disabled={isLoading}
-              className="px-2 py-1 bg-white hover:bg-gray-50 border border-gray-300 text-gray-700 rounded text-xs transition-colors disabled:opacity-50"
-            >
-              Modern
-            </button>
-            <button
-              type="button"
-              onClick={() => handleQuickPrompt('Generate a minimalist room')}
-              disabled={isLoading}
-              className="px-2 py-1 bg-white hover:bg-gray-50 border border-gray-300 text-gray-700 rounded text-xs transition-colors disabled:opacity-50"
-            >
-              Minimalist
-            </button>
+            {QUICK_PROMPTS.map(({ label, prompt }) => (
+              <button
+                key={prompt}
+                type="button"
+                onClick={() => handleQuickPrompt(prompt)}
+                className="px-2 py-1 bg-white hover:bg-gray-50 border border-gray-300 text-gray-700 rounded text-xs transition-colors"
+              >
+                {label}
+              </button>
+            ))}
           </div>
         )}
       </form>
     </div>
   );
 }
+
+export default memo(ChatBox);
@@ -0,0 +1,115 @@
+'use client';
+
+import { useEffect, useState } from 'react';
+import { DesignSummary, listDesigns, prepareDesigns, syncDesigns } from '@/lib/designStore';
+import { FurnitureStore, useFurnitureStats } from '@/lib/furnitureStore';
+import { isAbortError } from '@/lib/retrievalBackend';
+
+interface DesignMenuProps {
+  onSave: (name: string) => Promise<DesignSummary>;
+  onRestore: (id: string) => Promise<boolean>; // False when the design is gone
+  store: FurnitureStore; // Saving is offered once the room has furniture
+}
+
+const formatSavedAt = (savedAt: number) =>
+  new Date(savedAt).toLocaleString([], { dateStyle: 'short', timeStyle: 'short' });
+
+/**
+ * Save and restore controls for the current design
+ */
+export default function DesignMenu({ onSave, onRestore, store }: DesignMenuProps) {
+  const canSave = useFurnitureStats(store).totalCount > 0;
+  const [designs, setDesigns] = useState<DesignSummary[]>([]);
+  const [selectedId, setSelectedId] = useState('');
+  const [busy, setBusy] = useState(false);
+  const [status, setStatus] = useState('');
+
+  // Local designs first, then any newer ones from the sync endpoint
+  useEffect(() => {
+    const controller = new AbortController();
+    prepareDesigns();
+    listDesigns()
+      .then(local => {
+        if (!controller.signal.aborted) setDesigns(local);
+        return syncDesigns(controller.signal);
+      })
+      .then(merged => {
+        if (!controller.signal.aborted) setDesigns(merged);
+      })
+      .catch(error => {
+        if (!isAbortError(error)) console.warn('Saved designs unavailable:', error);
+      });
+    return () => controller.abort();
+  }, []);
+
+  const handleSave = async () => {
+    setBusy(true);
+    try {
+      const summary = await onSave(`Design ${designs.length + 1}`);
+      setDesigns(prev => [summary, ...prev.filter(design => design.id !== summary.id)]);
+      setSelectedId(summary.id);
+      setStatus(`Saved ${summary.itemCount} items`);
+    } catch (error) {
+      console.error('Error saving design:', error);
+      setStatus('Could not save');
+    } finally {
+      setBusy(false);
+    }
+  };
+
+  const handleRestore = async () => {
+    if (!selectedId) return;
+    setBusy(true);
+    try {
+      const start = performance.now();
+      const restored = await onRestore(selectedId);
+      if (restored) {
+        setStatus(`Restored in ${(performance.now() - start).toFixed(0)} ms`);
+      } else {
+        setDesigns(prev => prev.filter(design => design.id !== selectedId));
+        setSelectedId('');
+        setStatus('That design is no longer saved');
+      }
+    } catch (error) {
+      console.error('Error restoring design:', error);
+      setStatus('Could not restore');
+    } finally {
+      setBusy(false);
+    }
+  };
+
+  return (
+    <div className="mt-3 space-y-1.5 text-xs">
+      <div className="flex gap-2">
+        <select
+          value={selectedId}
+          onChange={e => setSelectedId(e.target.value)}
+          disabled={busy || designs.length === 0}
+          className="flex-1 min-w-0 border border-gray-300 rounded px-1.5 py-1 bg-white text-gray-700 disabled:text-gray-400"
+        >
+          <option value="">{designs.length === 0 ? 'No saved designs' : 'Saved designs…'}</option>
+          {designs.map(design => (
+            <option key={design.id} value={design.id}>
+              {design.name} · {formatSavedAt(design.savedAt)}
+            </option>
+          ))}
+        </select>
+        <button
+          onClick={handleRestore}
+          disabled={busy || !selectedId}
+          className="px-2 py-1 rounded bg-gray-100 text-gray-700 hover:bg-gray-200 disabled:opacity-50 disabled:cursor-not-allowed transition-colors"
+        >
+          Restore
+        </button>
+        <button
+          onClick={handleSave}
+          disabled={busy || !canSave}
+          className="px-2 py-1 rounded bg-primary-600 text-white hover:bg-primary-700 disabled:opacity-50 disabled:cursor-not-allowed transition-colors"
+        >
+          Save
+        </button>
+      </div>
+      {status && <p className="text-gray-500">{status}</p>}
+    </div>
+  );
+}
@@ -0,0 +1,88 @@
+'use client';
+
+import { useLayoutEffect, useRef } from 'react';
+import * as THREE from 'three';
+import { useThree } from '@react-three/fiber';
+import { FloorPlan, FloorPlanRoom } from '@/types/furniture';
+import { rgbToHex } from '@/lib/furnitureColors';
+import { wallSegments } from '@/lib/floorPlan';
+import type { RoomProxy } from '@/lib/roomStreamer';
+import { useSharedGeometry, useSharedMaterial } from '@/lib/sceneResources';
+
+const PROXY_COLOR = '#c8c0b4';
+const scratchMatrix = new THREE.Matrix4();
+const scratchPosition = new THREE.Vector3();
+const scratchScale = new THREE.Vector3();
+const IDENTITY = new THREE.Quaternion();
+
+/**
+ * Floor and walls of one room
+ * Walls are single-sided and face into the room, so from outside the wall
+ * nearest the camera is dropped by back-face culling instead of hiding
+ * the furniture behind it. Doorways are gaps in the walls. Floors and walls
+ * scale one shared unit plane and share materials by colour.
+ */
+export function RoomShell({ plan, room, visible }: {
+  plan: FloorPlan;
+  room: FloorPlanRoom;
+  visible: boolean;
+}) {
+  const { width, length, height, wallColor, floorColor } = room.config;
+  const walls = wallSegments(plan, room);
+  const plane = useSharedGeometry('plane');
+  const floorMaterial = useSharedMaterial('standard', rgbToHex(floorColor.r, floorColor.g, floorColor.b));
+  const wallMaterial = useSharedMaterial('standard', rgbToHex(wallColor.r, wallColor.g, wallColor.b));
+
+  return (
+    <group visible={visible}>
+      <mesh
+        geometry={plane}
+        material={floorMaterial}
+        rotation={[-Math.PI / 2, 0, 0]}
+        position={[room.origin.x, 0, room.origin.z]}
+        scale={[width, length, 1]}
+        receiveShadow
+      />
+
+      {walls.map(wall => (
+        <mesh
+          key={wall.key}
+          geometry={plane}
+          material={wallMaterial}
+          position={[wall.x, height / 2, wall.z]}
+          rotation={[0, wall.rotationY, 0]}
+          scale={[wall.length, height, 1]}
+          receiveShadow
+        />
+      ))}
+    </group>
+  );
+}
+
+/**
+ * An unloaded room's furniture as plain boxes in one draw call
+ */
+export function RoomProxyMesh({ proxy }: { proxy: RoomProxy }) {
+  const meshRef = useRef<THREE.InstancedMesh>(null);
+  const geometry = useSharedGeometry('box');
+  const material = useSharedMaterial('standard', PROXY_COLOR);
+  const invalidate = useThree(state => state.invalidate);
+
+  useLayoutEffect(() => {
+    const mesh = meshRef.current;
+    if (!mesh) return;
+    const { boxes, count } = proxy;
+    for (let i = 0; i < count; i++) {
+      const b = i * 6;
+      scratchPosition.set(boxes[b], boxes[b + 1], boxes[b + 2]);
+      scratchScale.set(boxes[b + 3], boxes[b + 4], boxes[b + 5]);
+      mesh.setMatrixAt(i, scratchMatrix.compose(scratchPosition, IDENTITY, scratchScale));
+    }
+    mesh.instanceMatrix.needsUpdate = true;
+    mesh.computeBoundingSphere();
+    invalidate();
+  }, [proxy, geometry, material, invalidate]);
+
+  if (proxy.count === 0) return null;
+  return <instancedMesh ref={meshRef} args={[geometry, material, proxy.count]} />;
+}
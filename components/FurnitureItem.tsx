@@ -1,7 +1,8 @@
 'use client';
 
+import { memo } from 'react';
 import { Furniture } from '@/types/furniture';
-import { CATEGORY_COLORS } from '@/lib/furnitureData';
+import { CATEGORY_COLORS } from '@/lib/furnitureColors';
 
 interface FurnitureItemProps {
   item: Furniture;
@@ -11,8 +12,11 @@ interface FurnitureItemProps {
 /**
  * Individual furniture item card component
  * Displays furniture metadata and visibility toggle
+ * Memoized: reconciled items keep their identity, so unchanged cards skip rendering
+ * Every line is truncated or clamped, so the card fits the list's fixed row
+ * height (see VirtualFurnitureList) whatever the text
  */
-export default function FurnitureItem({ item, onToggleVisibility }: FurnitureItemProps) {
+function FurnitureItem({ item, onToggleVisibility }: FurnitureItemProps) {
   const categoryColor = CATEGORY_COLORS[item.category];
 
   // Generate confidence bar width
@@ -24,7 +28,7 @@ export default function FurnitureItem({ item, onToggleVisibility }: FurnitureIte
   return (
     <div
       className={`
-        p-3 rounded-lg border-2 transition-all duration-200
+        h-full overflow-hidden p-3 rounded-lg border-2 transition-all duration-200
         ${item.visible
           ? 'bg-white border-primary-500 shadow-md'
           : 'bg-gray-50 border-gray-200 opacity-60'
@@ -46,10 +50,10 @@ export default function FurnitureItem({ item, onToggleVisibility }: FurnitureIte
           <h3 className="font-semibold text-sm text-gray-900 truncate">
             {item.name}
           </h3>
-          <p className="text-xs text-gray-500 capitalize mt-0.5">
+          <p className="text-xs text-gray-500 capitalize mt-0.5 truncate">
             {item.category}
           </p>
-          <p className="text-xs text-gray-600 mt-1" title={dimensions}>
+          <p className="text-xs text-gray-600 mt-1 truncate" title={dimensions}>
             {dimensions}
           </p>
         </div>
@@ -97,3 +101,5 @@ export default function FurnitureItem({ item, onToggleVisibility }: FurnitureIte
     </div>
   );
 }
+
+export default memo(FurnitureItem);
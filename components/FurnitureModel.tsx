@@ -0,0 +1,115 @@
+'use client';
+
+import { Component, ReactNode, Suspense, useLayoutEffect, useMemo } from 'react';
+import { useLoader, useThree } from '@react-three/fiber';
+import { Detailed } from '@react-three/drei';
+import * as THREE from 'three';
+import { GLTFLoader } from 'three/examples/jsm/loaders/GLTFLoader.js';
+import { Dimensions, Furniture } from '@/types/furniture';
+import { configureGltfLoader, disposeModel, fitModelToDimensions, modelLevels } from '@/lib/modelLoader';
+import { applyCulledLayer } from '@/lib/culling';
+import { useRetainedModel } from '@/lib/sceneResources';
+
+// Distinguishes loads of the same URL, so a reload is counted on its own
+const loadIds = new WeakMap<object, number>();
+let nextLoadId = 0;
+
+function loadKey(url: string, gltf: object): string {
+  let id = loadIds.get(gltf);
+  if (id === undefined) {
+    id = nextLoadId++;
+    loadIds.set(gltf, id);
+  }
+  return `${url}#${id}`;
+}
+
+/**
+ * Draws the primitives instead when a model fails to load
+ */
+class ModelErrorBoundary extends Component<{ fallback: ReactNode; children: ReactNode }, { failed: boolean }> {
+  state = { failed: false };
+
+  static getDerivedStateFromError() {
+    return { failed: true };
+  }
+
+  componentDidCatch(error: unknown) {
+    console.error('Error loading furniture model:', error);
+  }
+
+  render() {
+    return this.state.failed ? this.props.fallback : this.props.children;
+  }
+}
+
+/**
+ * One level of detail, fitted to the item's dimensions
+ * Items showing the same model share its load, which is disposed and
+ * dropped from the loader cache when the last of them unmounts
+ */
+function ModelLevel({ url, dimensions, culled, castShadow }: {
+  url: string;
+  dimensions: Dimensions;
+  culled: boolean;
+  castShadow: boolean;
+}) {
+  const gltf = useLoader(GLTFLoader, url, configureGltfLoader);
+  useRetainedModel(loadKey(url, gltf), () => {
+    disposeModel(gltf.scene);
+    useLoader.clear(GLTFLoader, url);
+  });
+  const gl = useThree(state => state.gl);
+  const invalidate = useThree(state => state.invalidate);
+  const { width, height, depth } = dimensions;
+  const model = useMemo(
+    () => fitModelToDimensions(gltf.scene, { width, height, depth }),
+    [gltf.scene, width, height, depth]
+  );
+
+  useLayoutEffect(() => {
+    model.traverse(object => {
+      if ((object as THREE.Mesh).isMesh) object.castShadow = castShadow;
+    });
+    // The model replaces the placeholder: redraw, including the cached shadow map
+    gl.shadowMap.needsUpdate = true;
+    invalidate();
+  }, [model, castShadow, gl, invalidate]);
+
+  // Culling changes what the camera sees, not the shadow map
+  useLayoutEffect(() => {
+    applyCulledLayer(model, culled);
+    invalidate();
+  }, [model, culled, invalidate]);
+
+  return <primitive object={model} />;
+}
+
+/**
+ * glTF furniture model with distance-based levels of detail
+ * Each level shows `fallback` (the placeholder primitives) until its model
+ * has streamed in
+ */
+export default function FurnitureModel({ item, fallback, culled, castShadow }: {
+  item: Furniture;
+  fallback: ReactNode;
+  culled: boolean;
+  castShadow: boolean;
+}) {
+  const levels = modelLevels(item);
+
+  // Each level sits in its own group so the LOD keeps a stable child per
+  // level while Suspense swaps the fallback for the model
+  return (
+    <Detailed distances={levels.map(level => level.distance)}>
+      {levels.map(level => (
+        <group key={level.url}>
+          <ModelErrorBoundary fallback={fallback}>
+            <Suspense fallback={fallback}>
+              <ModelLevel url={level.url} dimensions={item.dimensions} culled={culled} castShadow={castShadow} />
+            </Suspense>
+          </ModelErrorBoundary>
+        </group>
+      ))}
+    </Detailed>
+  );
+}
@@ -1,29 +1,34 @@
 'use client';
 
-import { Furniture } from '@/types/furniture';
-import FurnitureItem from './FurnitureItem';
-import { calculateRoomCoverage } from '@/lib/mockRAG';
+import { memo, useDeferredValue } from 'react';
+import VirtualFurnitureList from './VirtualFurnitureList';
+import { FurnitureStore, useFurnitureStats, useFurnitureStore } from '@/lib/furnitureStore';
 
 interface FurniturePanelProps {
-  furniture: Furniture[];
+  store: FurnitureStore;
   onToggleFurniture: (id: string) => void;
+  onSetAllVisible: (visible: boolean) => void;
   onRetrieveFurniture: () => void;
   isLoading: boolean;
 }
 
 /**
  * Sidebar panel component displaying retrieved furniture items
- * Includes controls for retrieval and statistics display
+ * Includes controls for retrieval and statistics display. Subscribes to
+ * the store itself and renders the list from a deferred copy, so a large
+ * retrieval result never holds up typing in the chat.
  */
-export default function FurniturePanel({
-  furniture,
+function FurniturePanel({
+  store,
   onToggleFurniture,
+  onSetAllVisible,
   onRetrieveFurniture,
   isLoading,
 }: FurniturePanelProps) {
-  // Calculate room statistics
-  const stats = calculateRoomCoverage(furniture, 10, 8);
-  const visibleCount = furniture.filter(f => f.visible).length;
+  const furniture = useDeferredValue(useFurnitureStore(store));
+  // Statistics are running totals kept by the furniture store
+  const stats = useDeferredValue(useFurnitureStats(store));
+  const allVisible = stats.visibleCount === stats.totalCount;
 
   return (
     <div className="h-full flex flex-col bg-gray-50">
@@ -79,7 +84,7 @@ export default function FurniturePanel({
           <div className="grid grid-cols-3 gap-2 text-center">
             <div>
               <div className="text-2xl font-bold text-primary-700">
-                {visibleCount}
+                {stats.visibleCount}
               </div>
               <div className="text-xs text-gray-600">Visible</div>
             </div>
@@ -96,12 +101,17 @@ export default function FurniturePanel({
               <div className="text-xs text-gray-600">Footprint</div>
             </div>
           </div>
+          {stats.overlapCount > 0 && (
+            <p className="text-xs text-amber-700 text-center mt-2">
+              {stats.overlapCount} overlapping {stats.overlapCount === 1 ? 'pair' : 'pairs'} counted once
+            </p>
+          )}
         </div>
       )}
 
       {/* Furniture list */}
-      <div className="flex-1 overflow-y-auto p-4">
-        {furniture.length === 0 ? (
+      {furniture.length === 0 ? (
+        <div className="flex-1 overflow-y-auto p-4">
           <div className="text-center py-12">
             <div className="text-gray-400 mb-3">
               <svg
@@ -123,37 +133,24 @@ export default function FurniturePanel({
               Click &quot;Retrieve Furniture&quot; to start
             </p>
           </div>
-        ) : (
-          <div className="space-y-3">
-            <div className="flex items-center justify-between mb-2">
-              <h3 className="text-sm font-semibold text-gray-700">
-                Retrieved Items ({furniture.length})
-              </h3>
-              <button
-                onClick={() => {
-                  // Toggle all furniture visibility
-                  const allVisible = furniture.every(f => f.visible);
-                  furniture.forEach(f => {
-                    if (allVisible !== f.visible) {
-                      onToggleFurniture(f.id);
-                    }
-                  });
-                }}
-                className="text-xs text-primary-600 hover:text-primary-700 font-medium"
-              >
-                {furniture.every(f => f.visible) ? 'Hide All' : 'Show All'}
-              </button>
-            </div>
-            {furniture.map(item => (
-              <FurnitureItem
-                key={item.id}
-                item={item}
-                onToggleVisibility={onToggleFurniture}
-              />
-            ))}
+        </div>
+      ) : (
+        <>
+          {/* List header stays outside the scroll container */}
+          <div className="flex items-center justify-between px-4 pt-4 pb-2">
+            <h3 className="text-sm font-semibold text-gray-700">
+              Retrieved Items ({furniture.length})
+            </h3>
+            <button
+              onClick={() => onSetAllVisible(!allVisible)}
+              className="text-xs text-primary-600 hover:text-primary-700 font-medium"
+            >
+              {allVisible ? 'Hide All' : 'Show All'}
+            </button>
           </div>
-        )}
-      </div>
+          <VirtualFurnitureList items={furniture} onToggleVisibility={onToggleFurniture} />
+        </>
+      )}
 
       {/* Footer info */}
       <div className="p-3 bg-white border-t border-gray-200">
@@ -164,3 +161,5 @@ export default function FurniturePanel({
     </div>
   );
 }
+
+export default memo(FurniturePanel);
@@ -0,0 +1,251 @@
+'use client';
+
+import { useLayoutEffect, useMemo, useRef } from 'react';
+import * as THREE from 'three';
+import { useThree } from '@react-three/fiber';
+import { Furniture } from '@/types/furniture';
+import { FurniturePart, composePartMatrix, getFurnitureParts } from '@/lib/furnitureParts';
+import { useInstancedMaterial, useSharedGeometry } from '@/lib/sceneResources';
+import { CULLED_LAYER } from '@/lib/culling';
+
+/**
+ * Minimum number of items in a category before it is drawn instanced
+ * Smaller groups are cheaper to keep as individual meshes
+ */
+export const INSTANCING_THRESHOLD = 3;
+
+/**
+ * A group of furniture parts drawn with a single InstancedMesh
+ */
+export interface InstanceBatch {
+  key: string;
+  part: FurniturePart;
+  items: Furniture[];
+}
+
+/**
+ * Splits furniture into instanced batches and individually drawn items
+ * A category is instanced once it has at least INSTANCING_THRESHOLD items;
+ * the split ignores visibility so toggling never moves an item between paths.
+ * Items with a glTF model are always drawn individually.
+ */
+export function partitionForInstancing(furniture: Furniture[]): {
+  batches: InstanceBatch[];
+  singles: Furniture[];
+} {
+  const byCategory = new Map<string, Furniture[]>();
+  const singles: Furniture[] = [];
+  furniture.forEach(item => {
+    // Items with their own model are drawn individually
+    if (item.modelUrl) {
+      singles.push(item);
+      return;
+    }
+    const group = byCategory.get(item.category);
+    if (group) {
+      group.push(item);
+    } else {
+      byCategory.set(item.category, [item]);
+    }
+  });
+
+  const batches: InstanceBatch[] = [];
+
+  byCategory.forEach((items, category) => {
+    if (items.length < INSTANCING_THRESHOLD) {
+      singles.push(...items);
+      return;
+    }
+    getFurnitureParts(items[0].category).forEach(part => {
+      batches.push({ key: `${category}:${part.key}`, part, items });
+    });
+  });
+
+  return { batches, singles };
+}
+
+/**
+ * Rounds the instance buffer size up to a power of two so that small
+ * changes in item count reuse the same InstancedMesh
+ */
+function batchCapacity(count: number): number {
+  let capacity = 16;
+  while (capacity < count) capacity *= 2;
+  return capacity;
+}
+
+// Hidden instances collapse to a zero-sized matrix instead of leaving the buffer
+const HIDDEN_MATRIX = new THREE.Matrix4().makeScale(0, 0, 0);
+const scratchMatrix = new THREE.Matrix4();
+const scratchColor = new THREE.Color();
+
+/**
+ * Stable instance slot assignment for one batch
+ * Items keep their slot across updates so that only changed slots are rewritten
+ */
+interface SlotTable {
+  mesh: THREE.InstancedMesh | null;
+  slotById: Map<string, number>;
+  itemBySlot: (Furniture | null)[];
+  shownBySlot: boolean[];
+  freeSlots: number[];
+}
+
+function createSlotTable(mesh: THREE.InstancedMesh | null): SlotTable {
+  return { mesh, slotById: new Map(), itemBySlot: [], shownBySlot: [], freeSlots: [] };
+}
+
+function writeInstance(
+  mesh: THREE.InstancedMesh,
+  slot: number,
+  item: Furniture | null,
+  part: FurniturePart,
+  shown: boolean
+) {
+  if (item && shown) {
+    composePartMatrix(item, part, scratchMatrix);
+    mesh.setMatrixAt(slot, scratchMatrix);
+  } else {
+    mesh.setMatrixAt(slot, HIDDEN_MATRIX);
+  }
+  if (item) {
+    const { r, g, b } = item.color;
+    mesh.setColorAt(slot, scratchColor.setRGB(r / 255, g / 255, b / 255, THREE.SRGBColorSpace));
+  }
+}
+
+/**
+ * Brings the slot table in line with `items`, writing only slots whose item
+ * object or visibility changed; returns the dirty slot range, or null when
+ * nothing changed
+ */
+function syncSlots(
+  mesh: THREE.InstancedMesh,
+  table: SlotTable,
+  items: Furniture[],
+  part: FurniturePart
+): [number, number] | null {
+  let dirtyMin = Infinity;
+  let dirtyMax = -1;
+  const markDirty = (slot: number) => {
+    if (slot < dirtyMin) dirtyMin = slot;
+    if (slot > dirtyMax) dirtyMax = slot;
+  };
+
+  const present = new Set<string>();
+  items.forEach(item => present.add(item.id));
+
+  // Free slots of removed items
+  table.slotById.forEach((slot, id) => {
+    if (present.has(id)) return;
+    table.slotById.delete(id);
+    table.itemBySlot[slot] = null;
+    table.shownBySlot[slot] = false;
+    table.freeSlots.push(slot);
+    writeInstance(mesh, slot, null, part, false);
+    markDirty(slot);
+  });
+
+  items.forEach(item => {
+    let slot = table.slotById.get(item.id);
+    if (slot === undefined) {
+      slot = table.freeSlots.pop() ?? table.itemBySlot.length;
+      table.slotById.set(item.id, slot);
+    }
+    const shown = item.visible;
+    if (table.itemBySlot[slot] !== item || table.shownBySlot[slot] !== shown) {
+      table.itemBySlot[slot] = item;
+      table.shownBySlot[slot] = shown;
+      writeInstance(mesh, slot, item, part, shown);
+      markDirty(slot);
+    }
+  });
+
+  return dirtyMax === -1 ? null : [dirtyMin, dirtyMax];
+}
+
+/**
+ * One InstancedMesh for a category sub-part
+ * Visibility and color changes rewrite only the affected instance slots.
+ * Culling keeps every instance in the buffer, since a culled item may still
+ * cast a shadow into view; the mesh leaves the main camera's layers once
+ * all of its items are culled.
+ */
+function InstancedBatch({ part, items, culled, castShadow }: {
+  part: FurniturePart;
+  items: Furniture[];
+  culled: ReadonlySet<string>;
+  castShadow: boolean;
+}) {
+  const meshRef = useRef<THREE.InstancedMesh>(null);
+  const slotsRef = useRef<SlotTable>(createSlotTable(null));
+  const geometry = useSharedGeometry(part.shape);
+  const material = useInstancedMaterial(part.material);
+  const capacity = batchCapacity(items.length);
+  // Buffer writes bypass React props, so request a frame explicitly
+  const invalidate = useThree(state => state.invalidate);
+  const allCulled = useMemo(() => items.every(item => culled.has(item.id)), [items, culled]);
+
+  useLayoutEffect(() => {
+    const mesh = meshRef.current;
+    if (!mesh) return;
+
+    // A recreated mesh (new capacity or resources) starts with empty buffers
+    let table = slotsRef.current;
+    const fullUpload = table.mesh !== mesh;
+    if (fullUpload) {
+      table = slotsRef.current = createSlotTable(mesh);
+    }
+
+    const dirty = syncSlots(mesh, table, items, part);
+    if (!dirty) return;
+
+    const [first, last] = dirty;
+    mesh.count = table.itemBySlot.length;
+    mesh.instanceMatrix.clearUpdateRanges();
+    if (!fullUpload) mesh.instanceMatrix.addUpdateRange(first * 16, (last - first + 1) * 16);
+    mesh.instanceMatrix.needsUpdate = true;
+    if (mesh.instanceColor) {
+      mesh.instanceColor.clearUpdateRanges();
+      if (!fullUpload) mesh.instanceColor.addUpdateRange(first * 3, (last - first + 1) * 3);
+      mesh.instanceColor.needsUpdate = true;
+    }
+    mesh.computeBoundingSphere();
+    invalidate();
+  }, [items, part, geometry, material, capacity, invalidate]);
+
+  return (
+    <instancedMesh
+      ref={meshRef}
+      args={[geometry, material, capacity]}
+      layers={allCulled ? CULLED_LAYER : 0}
+      castShadow={castShadow}
+    />
+  );
+}
+
+const NONE_CULLED: ReadonlySet<string> = new Set();
+
+/**
+ * Draws batched furniture with one draw call per category sub-part
+ * Hidden items collapse to zero size and shade no pixels
+ */
+export default function InstancedFurniture({ batches, culled = NONE_CULLED, castShadow = false }: {
+  batches: InstanceBatch[];
+  culled?: ReadonlySet<string>;
+  castShadow?: boolean;
+}) {
+  return (
+    <>
+      {batches.map(batch => (
+        <InstancedBatch
+          key={batch.key}
+          part={batch.part}
+          items={batch.items}
+          culled={culled}
+          castShadow={castShadow}
+        />
+      ))}
+    </>
+  );
+}
@@ -0,0 +1,72 @@
+'use client';
+
+import { useEffect, useState } from 'react';
+import { PerfSnapshot, RETRIEVAL_STAGES, getPerfSnapshot } from '@/lib/perfMetrics';
+
+// Metrics are recorded continuously; the overlay only samples them
+const POLL_MS = 500;
+
+const ms = (value: number | undefined) => (value === undefined ? '–' : `${value.toFixed(1)} ms`);
+const count = (value: number) => value.toLocaleString();
+
+function Row({ label, value }: { label: string; value: string }) {
+  return (
+    <div className="flex justify-between gap-4">
+      <span className="text-gray-400">{label}</span>
+      <span className="tabular-nums">{value}</span>
+    </div>
+  );
+}
+
+/**
+ * Frame, renderer and retrieval metrics for development and ops
+ * Shown in development builds, or in production with `?perf` in the URL
+ */
+export default function PerfOverlay() {
+  const [enabled, setEnabled] = useState(false);
+  const [snapshot, setSnapshot] = useState<PerfSnapshot | null>(null);
+
+  // Read the URL after hydration so server and client render the same
+  useEffect(() => {
+    setEnabled(
+      process.env.NODE_ENV !== 'production' || new URLSearchParams(window.location.search).has('perf')
+    );
+  }, []);
+
+  useEffect(() => {
+    if (!enabled) return;
+    const update = () => setSnapshot(getPerfSnapshot());
+    update();
+    const timer = setInterval(update, POLL_MS);
+    return () => clearInterval(timer);
+  }, [enabled]);
+
+  if (!enabled || !snapshot) return null;
+  const { frames, renderer, lastRetrieval, retrievalP95 } = snapshot;
+
+  return (
+    <div className="bg-black/70 text-white rounded-lg p-3 text-xs backdrop-blur-sm font-mono w-56">
+      <div className="font-semibold mb-2 font-sans">Performance:</div>
+      <div className="space-y-0.5">
+        <Row label="frame p50" value={ms(frames.p50)} />
+        <Row label="frame p95" value={ms(frames.p95)} />
+        <Row label="frame p99" value={ms(frames.p99)} />
+        <Row label="draw calls" value={count(renderer.drawCalls)} />
+        <Row label="triangles" value={count(renderer.triangles)} />
+        <Row label="geometries" value={count(renderer.geometries)} />
+        <Row label="textures" value={count(renderer.textures)} />
+      </div>
+      <div className="font-semibold mt-2 mb-1 font-sans">Retrieval (last / p95):</div>
+      <div className="space-y-0.5">
+        {RETRIEVAL_STAGES.map(stage => (
+          <Row
+            key={stage}
+            label={stage}
+            value={`${ms(lastRetrieval?.[stage])} / ${ms(retrievalP95[stage])}`}
+          />
+        ))}
+        <Row label="total" value={`${ms(lastRetrieval?.total)} / ${ms(retrievalP95.total)}`} />
+      </div>
+    </div>
+  );
+}
@@ -0,0 +1,25 @@
+'use client';
+
+import { Grid } from '@react-three/drei';
+
+/**
+ * Floor grid for spatial reference
+ * Loaded as its own chunk; the room is readable without it on first paint
+ */
+export default function RoomGrid({ width, depth }: { width: number; depth: number }) {
+  return (
+    <Grid
+      args={[width, depth]}
+      cellSize={0.5}
+      cellThickness={0.5}
+      cellColor="#b0b0b0"
+      sectionSize={1}
+      sectionThickness={1}
+      sectionColor="#909090"
+      fadeDistance={25}
+      fadeStrength={1}
+      followCamera={false}
+      position={[0, 0.01, 0]}
+    />
+  );
+}
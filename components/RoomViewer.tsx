@@ -1,215 +1,434 @@
 'use client';
 
-import { useRef } from 'react';
-import { Canvas } from '@react-three/fiber';
-import { OrbitControls, Grid, PerspectiveCamera } from '@react-three/drei';
-import { Furniture } from '@/types/furniture';
+import {
+  ReactNode,
+  RefObject,
+  Suspense,
+  lazy,
+  memo,
+  startTransition,
+  useCallback,
+  useDeferredValue,
+  useLayoutEffect,
+  useMemo,
+  useRef,
+  useState,
+  useSyncExternalStore,
+} from 'react';
+import { Canvas, useFrame, useThree } from '@react-three/fiber';
+import { FloorPlan, Furniture } from '@/types/furniture';
 import * as THREE from 'three';
+import { rgbToHex } from '@/lib/furnitureColors';
+import { FurniturePart, getFurnitureParts } from '@/lib/furnitureParts';
+import { useSharedGeometry, useSharedMaterial } from '@/lib/sceneResources';
+import {
+  FrameTimeMonitor,
+  QUALITY_SETTINGS,
+  QualitySettings,
+  QualityTier,
+  detectQualityTier,
+  lowerTier,
+} from '@/lib/renderQuality';
+import { recordFrame } from '@/lib/perfMetrics';
+import { FurnitureStore, useFurnitureStore } from '@/lib/furnitureStore';
+import { CULLED_LAYER, SceneCuller } from '@/lib/culling';
+import { SINGLE_ROOM_PLAN, planPortals, roomCells } from '@/lib/floorPlan';
+import type { RoomStreamer, StreamedRoom } from '@/lib/roomStreamer';
+import {
+  loadFurnitureModel,
+  loadRoomGrid,
+  loadSceneControls,
+  loadSceneShadows,
+} from '@/lib/viewerChunks';
+import InstancedFurniture, { partitionForInstancing } from './InstancedFurniture';
+import { RoomProxyMesh, RoomShell } from './FloorPlanRooms';
+
+// Deferred chunks: the first frame renders without them
+const SceneControls = lazy(loadSceneControls);
+const RoomGrid = lazy(loadRoomGrid);
+const SceneShadows = lazy(loadSceneShadows);
+const FurnitureModel = lazy(loadFurnitureModel);
+
+/**
+ * Single sub-part of a furniture piece
+ * Draws a shared unit geometry scaled to the item's dimensions
+ */
+function FurniturePartMesh({ part, item, hexColor, culled, castShadow }: {
+  part: FurniturePart;
+  item: Furniture;
+  hexColor: string;
+  culled: boolean;
+  castShadow: boolean;
+}) {
+  const geometry = useSharedGeometry(part.shape);
+  const material = useSharedMaterial(part.material, hexColor);
+
+  return (
+    <mesh
+      geometry={geometry}
+      material={material}
+      position={part.offset(item.dimensions)}
+      scale={part.scale(item.dimensions)}
+      layers={culled ? CULLED_LAYER : 0}
+      castShadow={castShadow}
+    />
+  );
+}
 
 /**
  * Individual furniture piece rendered in 3D
- * Uses basic geometric shapes as placeholders
+ * Uses basic geometric shapes as placeholders, or until its model has loaded
+ * Memoized so that items surviving a retrieval are not re-rendered
  */
-function FurnitureMesh({ item }: { item: Furniture }) {
-  if (!item.visible) return null;
-
-  const { position, dimensions, color } = item;
-  const hexColor = `#${[color.r, color.g, color.b]
-    .map(x => {
-      const hex = x.toString(16);
-      return hex.length === 1 ? '0' + hex : hex;
-    })
-    .join('')}`;
-
-  // Different shapes for different furniture types
-  const getGeometry = () => {
-    switch (item.category) {
-      case 'lamp':
-        // Lamp: cylinder for stand, sphere for shade
-        return (
-          <group>
-            <mesh position={[0, 0, 0]}>
-              <cylinderGeometry args={[0.05, 0.05, dimensions.height * 0.8, 8]} />
-              <meshStandardMaterial color={hexColor} />
-            </mesh>
-            <mesh position={[0, dimensions.height * 0.4, 0]}>
-              <sphereGeometry args={[0.15, 16, 16]} />
-              <meshStandardMaterial color={hexColor} emissive={hexColor} emissiveIntensity={0.3} />
-            </mesh>
-          </group>
-        );
-      case 'chair':
-        // Chair: box seat with taller back
-        return (
-          <group>
-            <mesh position={[0, 0, 0]}>
-              <boxGeometry args={[dimensions.width, dimensions.height * 0.4, dimensions.depth]} />
-              <meshStandardMaterial color={hexColor} />
-            </mesh>
-            <mesh position={[0, dimensions.height * 0.3, -dimensions.depth * 0.35]}>
-              <boxGeometry args={[dimensions.width, dimensions.height * 0.6, dimensions.depth * 0.1]} />
-              <meshStandardMaterial color={hexColor} />
-            </mesh>
-          </group>
-        );
-      case 'shelf':
-        // Shelf: thinner box
-        return (
-          <mesh>
-            <boxGeometry args={[dimensions.width, dimensions.height, dimensions.depth]} />
-            <meshStandardMaterial color={hexColor} wireframe={false} transparent opacity={0.9} />
-          </mesh>
-        );
-      default:
-        // Default: simple box
-        return (
-          <mesh>
-            <boxGeometry args={[dimensions.width, dimensions.height, dimensions.depth]} />
-            <meshStandardMaterial color={hexColor} />
-          </mesh>
-        );
-    }
-  };
+const FurnitureMesh = memo(function FurnitureMesh({ item, culled, castShadow }: {
+  item: Furniture;
+  culled: boolean;
+  castShadow: boolean;
+}) {
+  const { position, color } = item;
+  const hexColor = rgbToHex(color.r, color.g, color.b);
+
+  const primitives = getFurnitureParts(item.category).map(part => (
+    <FurniturePartMesh
+      key={part.key}
+      part={part}
+      item={item}
+      hexColor={hexColor}
+      culled={culled}
+      castShadow={castShadow}
+    />
+  ));
 
+  // Hidden and culled items stay mounted so they keep their shared GPU
+  // resources. Culled items only leave the main camera's layers: they may
+  // still cast a shadow into view.
   return (
-    <group position={[position.x, position.y, position.z]}>
-      {getGeometry()}
+    <group
+      position={[position.x, position.y, position.z]}
+      rotation={[0, item.rotationY ?? 0, 0]}
+      visible={item.visible}
+    >
+      {item.modelUrl ? (
+        <Suspense fallback={primitives}>
+          <FurnitureModel item={item} fallback={primitives} culled={culled} castShadow={castShadow} />
+        </Suspense>
+      ) : (
+        primitives
+      )}
       {/* Hover outline effect could be added here */}
     </group>
   );
-}
+});
 
 /**
- * HDB Room structure with walls, floor, and ceiling
+ * HDB flat structure: every room's floor and walls, with proxies standing
+ * in for the furniture of rooms that are not loaded
  */
-function Room() {
-  const roomWidth = 10;
-  const roomLength = 8;
-  const roomHeight = 3;
-
-  const wallColor = '#f5f5f5';
-  const floorColor = '#d4c4b0';
+function Rooms({ plan, streamed, visibleRooms }: {
+  plan: FloorPlan;
+  streamed: StreamedRoom[];
+  visibleRooms: ReadonlySet<string>;
+}) {
+  const primary = plan.rooms[0];
 
   return (
     <group>
-      {/* Floor */}
-      <mesh rotation={[-Math.PI / 2, 0, 0]} position={[0, 0, 0]} receiveShadow>
-        <planeGeometry args={[roomWidth, roomLength]} />
-        <meshStandardMaterial color={floorColor} />
-      </mesh>
-
-      {/* Back wall */}
-      <mesh position={[0, roomHeight / 2, -roomLength / 2]} receiveShadow>
-        <planeGeometry args={[roomWidth, roomHeight]} />
-        <meshStandardMaterial color={wallColor} side={THREE.DoubleSide} />
-      </mesh>
-
-      {/* Left wall */}
-      <mesh
-        position={[-roomWidth / 2, roomHeight / 2, 0]}
-        rotation={[0, Math.PI / 2, 0]}
-        receiveShadow
-      >
-        <planeGeometry args={[roomLength, roomHeight]} />
-        <meshStandardMaterial color={wallColor} side={THREE.DoubleSide} />
-      </mesh>
-
-      {/* Right wall */}
-      <mesh
-        position={[roomWidth / 2, roomHeight / 2, 0]}
-        rotation={[0, -Math.PI / 2, 0]}
-        receiveShadow
-      >
-        <planeGeometry args={[roomLength, roomHeight]} />
-        <meshStandardMaterial color={wallColor} side={THREE.DoubleSide} />
-      </mesh>
-
-      {/* Grid helper for spatial reference */}
-      <Grid
-        args={[roomWidth, roomLength]}
-        cellSize={0.5}
-        cellThickness={0.5}
-        cellColor="#b0b0b0"
-        sectionSize={1}
-        sectionThickness={1}
-        sectionColor="#909090"
-        fadeDistance={25}
-        fadeStrength={1}
-        followCamera={false}
-        position={[0, 0.01, 0]}
-      />
+      {plan.rooms.map(room => (
+        <RoomShell key={room.id} plan={plan} room={room} visible={visibleRooms.has(room.id)} />
+      ))}
+
+      {streamed.map(({ room, detail, proxy }) =>
+        detail !== 'loaded' && proxy && visibleRooms.has(room.id) ? (
+          <RoomProxyMesh key={room.id} proxy={proxy} />
+        ) : null
+      )}
+
+      {/* Grid helper for spatial reference, in the main room */}
+      <Suspense fallback={null}>
+        <RoomGrid width={primary.config.width} depth={primary.config.length} />
+      </Suspense>
     </group>
   );
 }
 
 /**
  * Scene lighting setup
+ * The point light depends on the quality tier; shadows on the key light are
+ * switched on by SceneShadows once its chunk has loaded
  */
-function Lights() {
+function Lights({ quality, keyLightRef }: {
+  quality: QualitySettings;
+  keyLightRef: RefObject<THREE.DirectionalLight | null>;
+}) {
   return (
     <>
       {/* Ambient light for overall illumination */}
       <ambientLight intensity={0.6} />
 
       {/* Directional light for shadows and depth */}
-      <directionalLight
-        position={[5, 10, 5]}
-        intensity={0.8}
-        castShadow
-        shadow-mapSize-width={2048}
-        shadow-mapSize-height={2048}
-      />
+      <directionalLight ref={keyLightRef} position={[5, 10, 5]} intensity={0.8} />
 
       {/* Fill light from opposite side */}
       <directionalLight position={[-5, 5, -5]} intensity={0.3} />
 
       {/* Point light for additional warmth */}
-      <pointLight position={[0, 3, 0]} intensity={0.4} color="#fff5e6" />
+      {quality.pointLight && (
+        <pointLight position={[0, 3, 0]} intensity={0.4} color="#fff5e6" />
+      )}
     </>
   );
 }
 
+/**
+ * Picks the starting quality tier from the GPU, then steps it down if
+ * frames stay slow while the camera is moving
+ */
+function QualityController({ tier, onTierChange }: {
+  tier: QualityTier;
+  onTierChange: (tier: QualityTier) => void;
+}) {
+  const gl = useThree(state => state.gl);
+  const monitor = useRef(new FrameTimeMonitor());
+
+  useLayoutEffect(() => {
+    onTierChange(detectQualityTier(gl));
+  }, [gl, onTierChange]);
+
+  useFrame((_, delta) => {
+    if (tier !== 'low' && monitor.current.record(delta)) {
+      onTierChange(lowerTier(tier));
+    }
+  });
+
+  return null;
+}
+
+/**
+ * Feeds frame time and renderer counters to the performance metrics
+ * Mounted first in the canvas so its frame callback runs before all others;
+ * the frame ends when gl.render returns
+ */
+function PerfProbe() {
+  const gl = useThree(state => state.gl);
+  const frameStart = useRef(-1);
+
+  useFrame(() => {
+    frameStart.current = performance.now();
+  });
+
+  useLayoutEffect(() => {
+    const render = gl.render;
+    gl.render = (scene, camera) => {
+      render.call(gl, scene, camera);
+      if (frameStart.current < 0) return;
+      recordFrame(performance.now() - frameStart.current, gl.info);
+      frameStart.current = -1;
+    };
+    return () => {
+      gl.render = render;
+    };
+  }, [gl]);
+
+  return null;
+}
+
+/**
+ * Recomputes room and furniture culling whenever the camera or the
+ * furniture changes, and lets the streamer load and unload rooms for the
+ * camera; runs after the controls have moved the camera
+ */
+function CullingController({ culler, streamer, furniture, onCull }: {
+  culler: SceneCuller;
+  streamer?: RoomStreamer;
+  furniture: Furniture[];
+  onCull: (culler: SceneCuller) => void;
+}) {
+  const invalidate = useThree(state => state.invalidate);
+
+  // A new culler starts from its own initial sets
+  useLayoutEffect(() => {
+    onCull(culler);
+  }, [culler, onCull]);
+
+  useLayoutEffect(() => {
+    culler.setFurniture(furniture);
+    invalidate();
+  }, [culler, furniture, invalidate]);
+
+  // Rooms time out of view while the camera stands still, when the demand
+  // frame loop renders nothing; wake it for the streamer's next deadline
+  const wake = useRef<{ at: number; timer: number } | null>(null);
+  useLayoutEffect(
+    () => () => {
+      if (wake.current) window.clearTimeout(wake.current.timer);
+      wake.current = null;
+    },
+    [streamer]
+  );
+
+  useFrame(({ camera }) => {
+    if (culler.update(camera)) onCull(culler);
+    if (!streamer) return;
+    streamer.update(camera.position.x, camera.position.z, culler.visibleRooms);
+
+    const at = streamer.nextUpdateAt();
+    if (at === null || wake.current?.at === at) return;
+    if (wake.current) window.clearTimeout(wake.current.timer);
+    const timer = window.setTimeout(() => {
+      wake.current = null;
+      invalidate();
+    }, Math.max(0, at - performance.now()));
+    wake.current = { at, timer };
+  });
+
+  return null;
+}
+
 /**
  * Main 3D Room Viewer Component
  * Renders the room and furniture using React Three Fiber
  */
 interface RoomViewerProps {
-  furniture: Furniture[];
+  store: FurnitureStore;
   onResetCamera?: () => void;
+  frameloop?: 'demand' | 'always'; // 'always' renders every frame, for the scene benchmark
+  plan?: FloorPlan; // The store's furniture belongs to the plan's first room
+  streamer?: RoomStreamer; // Loads the other rooms' furniture
+  children?: ReactNode; // Extra content inside the canvas, e.g. the scene benchmark's timer
 }
 
-export default function RoomViewer({ furniture }: RoomViewerProps) {
-  const controlsRef = useRef<any>(null);
+const NO_STREAMED_ROOMS: StreamedRoom[] = [];
+const subscribeNone = () => () => {};
+const getNoStreamedRooms = () => NO_STREAMED_ROOMS;
+
+/**
+ * Canvas and camera controls. The viewer never re-renders for a furniture
+ * change: SceneContents subscribes from inside the canvas.
+ */
+export default function RoomViewer({
+  store,
+  frameloop = 'demand',
+  plan = SINGLE_ROOM_PLAN,
+  streamer,
+  children,
+}: RoomViewerProps) {
+  const [tier, setTier] = useState<QualityTier>('medium');
+  const quality = QUALITY_SETTINGS[tier];
 
   return (
     <div className="w-full h-full bg-gradient-to-b from-gray-800 to-gray-900">
-      <Canvas shadows>
-        {/* Camera setup */}
-        <PerspectiveCamera makeDefault position={[8, 6, 8]} fov={60} />
-
-        {/* Lighting */}
-        <Lights />
-
-        {/* Room structure */}
-        <Room />
-
-        {/* Furniture items */}
-        {furniture.map(item => (
-          <FurnitureMesh key={item.id} item={item} />
-        ))}
+      {/* Renders only when something changes: camera moves, furniture
+          updates or visibility toggles. Controls, grid and shadows arrive
+          as separate chunks after the first frame. */}
+      <Canvas
+        shadows
+        frameloop={frameloop}
+        dpr={[1, quality.maxDpr]}
+        performance={{ min: 0.5 }}
+        camera={{ position: [8, 6, 8], fov: 60 }}
+      >
+        <PerfProbe />
+        <QualityController tier={tier} onTierChange={setTier} />
+        <SceneContents store={store} plan={plan} streamer={streamer} quality={quality} />
 
         {/* Camera controls */}
-        <OrbitControls
-          ref={controlsRef}
-          enablePan={true}
-          enableZoom={true}
-          enableRotate={true}
-          minDistance={3}
-          maxDistance={20}
-          maxPolarAngle={Math.PI / 2 - 0.1} // Prevent going below floor
-          target={[0, 1, 0]}
-        />
+        <Suspense fallback={null}>
+          <SceneControls />
+        </Suspense>
+        {children}
       </Canvas>
     </div>
   );
 }
+
+/**
+ * Subscribes to the furniture store and room streamer inside R3F's own
+ * root. The outer React tree hands the canvas its children from a layout
+ * effect at blocking priority, so a subscription outside the canvas would
+ * reconcile every mesh synchronously however its value was deferred.
+ * Subscribed here, a store update renders SceneContents urgently with the
+ * previous deferred values, which the memoized SceneGraph skips, and the
+ * mesh reconciliation follows in a transition that yields to input.
+ */
+function SceneContents({ store, plan, streamer, quality }: {
+  store: FurnitureStore;
+  plan: FloorPlan;
+  streamer?: RoomStreamer;
+  quality: QualitySettings;
+}) {
+  const furniture = useDeferredValue(useFurnitureStore(store));
+  // Furniture of every loaded room
+  const streamed = useDeferredValue(
+    useSyncExternalStore(
+      streamer?.subscribe ?? subscribeNone,
+      streamer?.getSnapshot ?? getNoStreamedRooms,
+      getNoStreamedRooms
+    )
+  );
+
+  return (
+    <SceneGraph furniture={furniture} streamed={streamed} plan={plan} streamer={streamer} quality={quality} />
+  );
+}
+
+/**
+ * Rooms, lights, furniture and shadows
+ */
+const SceneGraph = memo(function SceneGraph({ furniture, streamed, plan, streamer, quality }: {
+  furniture: Furniture[];
+  streamed: StreamedRoom[];
+  plan: FloorPlan;
+  streamer?: RoomStreamer;
+  quality: QualitySettings;
+}) {
+  const keyLightRef = useRef<THREE.DirectionalLight>(null);
+
+  const sceneFurniture = useMemo(() => {
+    const loaded = streamed.filter(room => room.furniture.length > 0);
+    return loaded.length === 0 ? furniture : furniture.concat(...loaded.map(room => room.furniture));
+  }, [furniture, streamed]);
+
+  // Only rooms and furniture the camera can see are drawn
+  const culler = useMemo(() => new SceneCuller(roomCells(plan), planPortals(plan)), [plan]);
+  const [visibility, setVisibility] = useState(() => ({
+    culled: culler.culled,
+    rooms: culler.visibleRooms,
+  }));
+  // Culling follows the camera; a change re-renders the scene, which may
+  // wait behind input
+  const handleCull = useCallback((current: SceneCuller) => {
+    const next = { culled: current.culled, rooms: current.visibleRooms };
+    startTransition(() => setVisibility(next));
+  }, []);
+  const { culled } = visibility;
+
+  // Group crowded categories into instanced batches
+  const { batches, singles } = useMemo(() => partitionForInstancing(sceneFurniture), [sceneFurniture]);
+
+  return (
+    <>
+      <CullingController culler={culler} streamer={streamer} furniture={sceneFurniture} onCull={handleCull} />
+
+      {/* Lighting */}
+      <Lights quality={quality} keyLightRef={keyLightRef} />
+
+      {/* Room structure */}
+      <Rooms plan={plan} streamed={streamed} visibleRooms={visibility.rooms} />
+
+      {/* Furniture items */}
+      <InstancedFurniture batches={batches} culled={culled} castShadow={quality.furnitureShadows} />
+      {singles.map(item => (
+        <FurnitureMesh
+          key={item.id}
+          item={item}
+          culled={culled.has(item.id)}
+          castShadow={quality.furnitureShadows}
+        />
+      ))}
+
+      <Suspense fallback={null}>
+        <SceneShadows lightRef={keyLightRef} plan={plan} furniture={sceneFurniture} quality={quality} />
+      </Suspense>
+    </>
+  );
+});
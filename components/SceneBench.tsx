@@ -0,0 +1,120 @@
+'use client';
+
+import { useEffect, useRef, useState } from 'react';
+import dynamic from 'next/dynamic';
+import { useFrame } from '@react-three/fiber';
+import { FurnitureStore } from '@/lib/furnitureStore';
+import { getPerfSnapshot, percentiles } from '@/lib/perfMetrics';
+import { createSyntheticCatalogue } from '@/lib/syntheticCatalogue';
+import { loadRoomViewer, prefetchViewerChunks } from '@/lib/viewerChunks';
+
+const RoomViewer = dynamic(loadRoomViewer, { ssr: false });
+
+// Lets lazy chunks, shaders and the first shadow pass settle before timing
+const WARMUP_MS = 2000;
+const MEASURE_MS = 5000;
+
+interface SceneBenchReport {
+  items: number;
+  frames: number;
+  p50: number;
+  p95: number;
+  p99: number;
+  drawCalls: number;
+  triangles: number;
+  userAgent: string;
+}
+
+/**
+ * Renders the scene itself and times each gl.render call
+ * A useFrame callback with a positive priority takes over rendering from
+ * R3F, and runs after every other frame callback. Timing the call rather
+ * than requestAnimationFrame deltas measures the CPU cost of a frame,
+ * which vsync does not round up to the display's refresh interval.
+ */
+function RenderTimer({ onSample }: { onSample: (ms: number) => void }) {
+  useFrame(({ gl, scene, camera }) => {
+    const start = performance.now();
+    gl.render(scene, camera);
+    onSample(performance.now() - start);
+  }, 1);
+  return null;
+}
+
+/**
+ * Scene benchmark, driven by bench/scene.bench.ts
+ *
+ *   /bench/scene?items=100&report=http://127.0.0.1:9400/report
+ *
+ * Renders `items` synthetic furniture with a continuous frame loop, times
+ * the CPU side of each render after a warm-up and POSTs the percentiles
+ * with the renderer counters to `report`.
+ */
+export default function SceneBench() {
+  const [params, setParams] = useState<{ items: number; report: string } | null>(null);
+  const [report, setReport] = useState<SceneBenchReport | null>(null);
+
+  useEffect(() => {
+    const search = new URLSearchParams(window.location.search);
+    setParams({ items: Number(search.get('items') ?? 100), report: search.get('report') ?? '' });
+    prefetchViewerChunks();
+  }, []);
+
+  const [store] = useState(() => new FurnitureStore());
+
+  useEffect(() => {
+    if (params) store.replace(createSyntheticCatalogue(params.items).map(item => ({ ...item, visible: true })));
+  }, [params, store]);
+
+  // Render times land here once the warm-up is over
+  const renderTimes = useRef<number[] | null>(null);
+
+  useEffect(() => {
+    if (!params) return;
+    let cancelled = false;
+    const warmup = setTimeout(() => {
+      renderTimes.current = [];
+    }, WARMUP_MS);
+
+    const done = setTimeout(() => {
+      if (cancelled) return;
+      const { p50, p95, p99, samples } = percentiles(renderTimes.current ?? []);
+      renderTimes.current = null;
+      const { renderer } = getPerfSnapshot();
+      const result: SceneBenchReport = {
+        items: params.items,
+        frames: samples,
+        p50,
+        p95,
+        p99,
+        drawCalls: renderer.drawCalls,
+        triangles: renderer.triangles,
+        userAgent: navigator.userAgent,
+      };
+      setReport(result);
+      if (params.report) {
+        // text/plain keeps the cross-origin POST free of a preflight
+        fetch(params.report, { method: 'POST', mode: 'no-cors', body: JSON.stringify(result) }).catch(() => {});
+      }
+    }, WARMUP_MS + MEASURE_MS);
+
+    return () => {
+      cancelled = true;
+      clearTimeout(warmup);
+      clearTimeout(done);
+    };
+  }, [params]);
+
+  return (
+    <main className="w-screen h-screen relative">
+      {params && (
+        <RoomViewer store={store} frameloop="always">
+          <RenderTimer onSample={ms => renderTimes.current?.push(ms)} />
+        </RoomViewer>
+      )}
+      <pre className="absolute top-2 left-2 text-xs text-white bg-black/60 p-2 rounded">
+        {report ? JSON.stringify(report, null, 2) : `Measuring ${params?.items ?? ''} items...`}
+      </pre>
+    </main>
+  );
+}
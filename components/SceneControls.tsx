@@ -0,0 +1,54 @@
+'use client';
+
+import { useEffect, useRef } from 'react';
+import { useFrame, useThree } from '@react-three/fiber';
+import { AdaptiveDpr, OrbitControls } from '@react-three/drei';
+
+// How long to keep rendering after the user lets go, so damping can finish
+const SETTLE_MS = 500;
+
+/**
+ * Camera controls for the room viewer
+ * Loaded as its own chunk after the first frame; until then the camera
+ * stays at its initial position
+ */
+export default function SceneControls() {
+  const controlsRef = useRef<any>(null);
+  const invalidate = useThree(state => state.invalidate);
+  const settleUntil = useRef(0);
+
+  // OrbitControls requests frames while it is moving; keep the demand loop
+  // running briefly after pointer events stop to cover the damping tail
+  useEffect(() => {
+    const controls = controlsRef.current;
+    if (!controls) return;
+    const onEnd = () => {
+      settleUntil.current = performance.now() + SETTLE_MS;
+      invalidate();
+    };
+    controls.addEventListener('end', onEnd);
+    return () => controls.removeEventListener('end', onEnd);
+  }, [invalidate]);
+
+  useFrame(() => {
+    if (performance.now() < settleUntil.current) invalidate();
+  });
+
+  return (
+    <>
+      {/* Resolution drops while moving */}
+      <AdaptiveDpr pixelated />
+      <OrbitControls
+        ref={controlsRef}
+        enablePan={true}
+        enableZoom={true}
+        enableRotate={true}
+        minDistance={3}
+        maxDistance={20}
+        maxPolarAngle={Math.PI / 2 - 0.1} // Prevent going below floor
+        target={[0, 1, 0]}
+        regress
+      />
+    </>
+  );
+}
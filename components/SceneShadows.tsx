@@ -0,0 +1,114 @@
+'use client';
+
+import { RefObject, useLayoutEffect } from 'react';
+import * as THREE from 'three';
+import { useThree } from '@react-three/fiber';
+import { FloorPlan, Furniture } from '@/types/furniture';
+import { QualitySettings } from '@/lib/renderQuality';
+import { CULLED_LAYER } from '@/lib/culling';
+import { planBounds } from '@/lib/floorPlan';
+
+// Metres added around the plan so shadows at its edge are not clipped
+const SHADOW_MARGIN = 0.5;
+const scratchCorner = new THREE.Vector3();
+
+/**
+ * Fits an orthographic shadow camera, already placed at its light, to the
+ * plan's rooms from the floor up to the tallest ceiling
+ */
+function fitShadowCamera(camera: THREE.OrthographicCamera, plan: FloorPlan) {
+  const { minX, minZ, maxX, maxZ } = planBounds(plan);
+  const maxY = Math.max(...plan.rooms.map(room => room.config.height));
+  const min = new THREE.Vector3(Infinity, Infinity, Infinity);
+  const max = new THREE.Vector3(-Infinity, -Infinity, -Infinity);
+  for (const x of [minX, maxX]) {
+    for (const y of [0, maxY]) {
+      for (const z of [minZ, maxZ]) {
+        scratchCorner.set(x, y, z).applyMatrix4(camera.matrixWorldInverse);
+        min.min(scratchCorner);
+        max.max(scratchCorner);
+      }
+    }
+  }
+  camera.left = min.x - SHADOW_MARGIN;
+  camera.right = max.x + SHADOW_MARGIN;
+  camera.bottom = min.y - SHADOW_MARGIN;
+  camera.top = max.y + SHADOW_MARGIN;
+  // The camera looks down -z
+  camera.near = Math.max(0.1, -max.z - SHADOW_MARGIN);
+  camera.far = -min.z + SHADOW_MARGIN;
+  camera.updateProjectionMatrix();
+}
+
+/**
+ * Shadow casting for the key light
+ *
+ * Loaded as its own chunk so the first frame skips the shadow pass. Once
+ * mounted it configures the light for the current tier, fits its shadow
+ * camera to the floor plan, and renders the shadow map only when something
+ * that casts shadows changes: the room shell and lights never move, so the
+ * last map stays valid until furniture, the plan or the tier changes.
+ *
+ * Culled furniture sits on CULLED_LAYER, which the main camera does not
+ * draw. The shadow pass tests casters against the main camera's layers, so
+ * the layer is enabled for that pass only: culled items keep casting
+ * shadows into view, and culling never invalidates the shadow map.
+ */
+export default function SceneShadows({ lightRef, plan, furniture, quality }: {
+  lightRef: RefObject<THREE.DirectionalLight | null>;
+  plan: FloorPlan;
+  furniture: Furniture[];
+  quality: QualitySettings;
+}) {
+  const gl = useThree(state => state.gl);
+  const invalidate = useThree(state => state.invalidate);
+
+  useLayoutEffect(() => {
+    const light = lightRef.current;
+    if (!light) return;
+
+    const size = quality.shadowMapSize;
+    light.castShadow = size > 0;
+    if (size > 0 && light.shadow.mapSize.x !== size) {
+      // three.js only allocates the shadow map once; drop it to resize
+      light.shadow.map?.dispose();
+      light.shadow.map = null;
+      light.shadow.mapSize.set(size, size);
+    }
+    // Place the shadow camera at the light before measuring the plan from it
+    light.updateMatrixWorld();
+    light.target.updateMatrixWorld();
+    light.shadow.updateMatrices(light);
+    fitShadowCamera(light.shadow.camera, plan);
+
+    return () => {
+      light.castShadow = false;
+    };
+  }, [lightRef, plan, quality.shadowMapSize]);
+
+  // The renderer projects the main render list before the shadow pass, so
+  // enabling the layer here does not draw culled items on screen
+  useLayoutEffect(() => {
+    const shadowMap = gl.shadowMap;
+    const render = shadowMap.render;
+    shadowMap.render = (lights, scene, camera) => {
+      camera.layers.enable(CULLED_LAYER);
+      try {
+        render.call(shadowMap, lights, scene, camera);
+      } finally {
+        camera.layers.disable(CULLED_LAYER);
+      }
+    };
+    return () => {
+      shadowMap.render = render;
+    };
+  }, [gl]);
+
+  useLayoutEffect(() => {
+    gl.shadowMap.autoUpdate = false;
+    gl.shadowMap.needsUpdate = true;
+    invalidate();
+  }, [gl, invalidate, plan, furniture, quality]);
+
+  return null;
+}
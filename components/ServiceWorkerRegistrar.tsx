@@ -0,0 +1,38 @@
+'use client';
+
+import { useEffect } from 'react';
+import { syncCatalogue } from '@/lib/catalogueSync';
+
+/**
+ * Registers the service worker and refreshes the local catalogue copy
+ * Both wait until the page has loaded so they never compete with startup
+ */
+export default function ServiceWorkerRegistrar() {
+  useEffect(() => {
+    const controller = new AbortController();
+
+    const start = () => {
+      // Development builds change constantly; caching them only gets in the way
+      if (process.env.NODE_ENV === 'production' && 'serviceWorker' in navigator) {
+        navigator.serviceWorker.register('/sw.js').catch(error => {
+          console.warn('Service worker registration failed:', error);
+        });
+      }
+      syncCatalogue(controller.signal).catch(error => {
+        if (!controller.signal.aborted) console.warn('Catalogue sync failed:', error);
+      });
+    };
+
+    if (document.readyState === 'complete') {
+      start();
+    } else {
+      window.addEventListener('load', start, { once: true });
+    }
+    return () => {
+      window.removeEventListener('load', start);
+      controller.abort();
+    };
+  }, []);
+
+  return null;
+}
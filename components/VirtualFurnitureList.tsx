@@ -0,0 +1,68 @@
+'use client';
+
+import { UIEvent, memo, useCallback, useLayoutEffect, useRef, useState } from 'react';
+import { Furniture } from '@/types/furniture';
+import FurnitureItem from './FurnitureItem';
+
+// Fixed slot per card (card height plus the gap below it). A constant row
+// height keeps the scroll math exact and the scroll position stable when
+// items are added, removed or toggled. FurnitureItem clamps every line, so
+// its tallest card, with a two-line description, is 164px.
+const ROW_HEIGHT = 176;
+const ROW_GAP = 12;
+const OVERSCAN = 4;
+
+interface VirtualFurnitureListProps {
+  items: Furniture[];
+  onToggleVisibility: (id: string) => void;
+}
+
+/**
+ * Windowed list of furniture cards
+ * Only the rows in view, plus a few above and below, are mounted. The
+ * list is memoized, so a panel render with unchanged items stops here
+ */
+function VirtualFurnitureList({ items, onToggleVisibility }: VirtualFurnitureListProps) {
+  const containerRef = useRef<HTMLDivElement>(null);
+  const [firstVisibleRow, setFirstVisibleRow] = useState(0);
+  const [viewportRows, setViewportRows] = useState(0);
+
+  // Track the viewport height so resizing the panel mounts enough rows
+  useLayoutEffect(() => {
+    const container = containerRef.current;
+    if (!container) return;
+
+    const measure = (height: number) => setViewportRows(Math.ceil(height / ROW_HEIGHT));
+    measure(container.clientHeight);
+
+    const observer = new ResizeObserver(entries => measure(entries[0].contentRect.height));
+    observer.observe(container);
+    return () => observer.disconnect();
+  }, []);
+
+  // Re-render only when scrolling crosses a row boundary
+  const handleScroll = useCallback((event: UIEvent<HTMLDivElement>) => {
+    setFirstVisibleRow(Math.floor(event.currentTarget.scrollTop / ROW_HEIGHT));
+  }, []);
+
+  const start = Math.max(0, firstVisibleRow - OVERSCAN);
+  const end = Math.min(items.length, firstVisibleRow + viewportRows + OVERSCAN);
+
+  return (
+    <div ref={containerRef} onScroll={handleScroll} className="flex-1 overflow-y-auto px-4 pb-4">
+      <div className="relative" style={{ height: items.length * ROW_HEIGHT }}>
+        {items.slice(start, end).map((item, offset) => (
+          <div
+            key={item.id}
+            className="absolute left-0 right-0"
+            style={{ top: (start + offset) * ROW_HEIGHT, height: ROW_HEIGHT, paddingBottom: ROW_GAP }}
+          >
+            <FurnitureItem item={item} onToggleVisibility={onToggleVisibility} />
+          </div>
+        ))}
+      </div>
+    </div>
+  );
+}
+
+export default memo(VirtualFurnitureList);
@@ -0,0 +1,257 @@
+import { FurnitureCategory } from '@/types/furniture';
+import type { CatalogueItem } from './catalogueManifest';
+import { categoryCode, categoryFromCode } from './furnitureCategories';
+
+/**
+ * Columnar binary catalogue
+ *
+ * One ArrayBuffer holds the whole catalogue as struct-of-arrays columns:
+ *
+ *   header      u32 × 5   magic, format version, rows, strings, string bytes
+ *   positions   f32 × 3n  x, y, z
+ *   dimensions  f32 × 3n  width, height, depth
+ *   confidence  f32 × n
+ *   id/name/description/model refs  u32 × n each, into the string table
+ *   string offsets  u32 × (strings + 1)
+ *   categories  u8 × n    codes from lib/furnitureCategories.ts
+ *   colors      u8 × 3n   r, g, b
+ *   string data utf8
+ *
+ * 4-byte columns come first so every typed array view is aligned. Decoding
+ * creates views over the buffer and copies nothing; strings are interned
+ * once in the table and decoded on first use. Model LOD lists are not
+ * stored; items keep their full-detail `modelUrl` only.
+ */
+
+const MAGIC = 0x54414344; // 'DCAT'
+const FORMAT_VERSION = 1;
+const HEADER_WORDS = 5;
+const NO_STRING = 0xffffffff;
+
+/**
+ * Float32 columns hold values like 0.9 as 0.899999976; round back to the
+ * shortest decimal that still maps to the same float
+ */
+function fromFloat32(value: number): number {
+  return Number(value.toPrecision(7));
+}
+
+/**
+ * Serializes catalogue items into the columnar format
+ */
+export function encodeCatalogue(items: CatalogueItem[]): ArrayBuffer {
+  const count = items.length;
+  const strings: string[] = [];
+  const stringIndex = new Map<string, number>();
+  const intern = (text: string | undefined) => {
+    if (text === undefined) return NO_STRING;
+    let ref = stringIndex.get(text);
+    if (ref === undefined) {
+      ref = strings.length;
+      strings.push(text);
+      stringIndex.set(text, ref);
+    }
+    return ref;
+  };
+
+  const idRefs = items.map(item => intern(item.id));
+  const nameRefs = items.map(item => intern(item.name));
+  const descriptionRefs = items.map(item => intern(item.description));
+  const modelRefs = items.map(item => intern(item.modelUrl));
+
+  const encoder = new TextEncoder();
+  const encodedStrings = strings.map(text => encoder.encode(text));
+  const stringBytes = encodedStrings.reduce((total, bytes) => total + bytes.length, 0);
+
+  const wordCount = HEADER_WORDS + count * 3 * 2 + count + count * 4 + strings.length + 1;
+  const buffer = new ArrayBuffer(wordCount * 4 + count * 4 + stringBytes);
+
+  let offset = 0;
+  const take32 = <T extends Float32Array | Uint32Array>(View: new (b: ArrayBuffer, o: number, l: number) => T, length: number) => {
+    const view = new View(buffer, offset, length);
+    offset += length * 4;
+    return view;
+  };
+  const take8 = (length: number) => {
+    const view = new Uint8Array(buffer, offset, length);
+    offset += length;
+    return view;
+  };
+
+  const header = take32(Uint32Array, HEADER_WORDS);
+  header.set([MAGIC, FORMAT_VERSION, count, strings.length, stringBytes]);
+
+  const positions = take32(Float32Array, count * 3);
+  const dimensions = take32(Float32Array, count * 3);
+  const confidence = take32(Float32Array, count);
+  take32(Uint32Array, count).set(idRefs);
+  take32(Uint32Array, count).set(nameRefs);
+  take32(Uint32Array, count).set(descriptionRefs);
+  take32(Uint32Array, count).set(modelRefs);
+  const stringOffsets = take32(Uint32Array, strings.length + 1);
+  const categories = take8(count);
+  const colors = take8(count * 3);
+  const stringData = take8(stringBytes);
+
+  items.forEach((item, row) => {
+    positions.set([item.position.x, item.position.y, item.position.z], row * 3);
+    dimensions.set([item.dimensions.width, item.dimensions.height, item.dimensions.depth], row * 3);
+    confidence[row] = item.confidenceScore;
+    categories[row] = categoryCode(item.category);
+    colors.set([item.color.r, item.color.g, item.color.b], row * 3);
+  });
+
+  let byte = 0;
+  encodedStrings.forEach((bytes, ref) => {
+    stringOffsets[ref] = byte;
+    stringData.set(bytes, byte);
+    byte += bytes.length;
+  });
+  stringOffsets[strings.length] = byte;
+
+  return buffer;
+}
+
+const decoder = new TextDecoder();
+
+/**
+ * Zero-copy view over an encoded catalogue
+ * The search indexes read the column arrays in place
+ */
+export class BinaryCatalogue {
+  readonly buffer: ArrayBuffer;
+  readonly count: number;
+  readonly positions: Float32Array;
+  readonly dimensions: Float32Array;
+  readonly confidence: Float32Array;
+  readonly categories: Uint8Array;
+  readonly colors: Uint8Array;
+
+  private readonly idRefs: Uint32Array;
+  private readonly nameRefs: Uint32Array;
+  private readonly descriptionRefs: Uint32Array;
+  private readonly modelRefs: Uint32Array;
+  private readonly stringOffsets: Uint32Array;
+  private readonly stringData: Uint8Array;
+  private readonly strings: (string | undefined)[];
+  private rowById: Map<string, number> | null = null;
+
+  constructor(buffer: ArrayBuffer) {
+    const header = new Uint32Array(buffer, 0, HEADER_WORDS);
+    const [magic, version, count, stringCount, stringBytes] = header;
+    if (magic !== MAGIC) throw new Error('Not a binary catalogue');
+    if (version !== FORMAT_VERSION) throw new Error(`Unsupported catalogue format version ${version}`);
+
+    let offset = HEADER_WORDS * 4;
+    const view32 = <T extends Float32Array | Uint32Array>(View: new (b: ArrayBuffer, o: number, l: number) => T, length: number) => {
+      const view = new View(buffer, offset, length);
+      offset += length * 4;
+      return view;
+    };
+    const view8 = (length: number) => {
+      const view = new Uint8Array(buffer, offset, length);
+      offset += length;
+      return view;
+    };
+
+    this.buffer = buffer;
+    this.count = count;
+    this.positions = view32(Float32Array, count * 3);
+    this.dimensions = view32(Float32Array, count * 3);
+    this.confidence = view32(Float32Array, count);
+    this.idRefs = view32(Uint32Array, count);
+    this.nameRefs = view32(Uint32Array, count);
+    this.descriptionRefs = view32(Uint32Array, count);
+    this.modelRefs = view32(Uint32Array, count);
+    this.stringOffsets = view32(Uint32Array, stringCount + 1);
+    this.categories = view8(count);
+    this.colors = view8(count * 3);
+    this.stringData = view8(stringBytes);
+    this.strings = new Array(stringCount);
+  }
+
+  static fromItems(items: CatalogueItem[]): BinaryCatalogue {
+    return new BinaryCatalogue(encodeCatalogue(items));
+  }
+
+  id(row: number): string {
+    return this.string(this.idRefs[row])!;
+  }
+
+  name(row: number): string {
+    return this.string(this.nameRefs[row])!;
+  }
+
+  description(row: number): string | undefined {
+    return this.string(this.descriptionRefs[row]);
+  }
+
+  modelUrl(row: number): string | undefined {
+    return this.string(this.modelRefs[row]);
+  }
+
+  category(row: number): FurnitureCategory {
+    return categoryFromCode(this.categories[row]);
+  }
+
+  /**
+   * Row of an item id, or -1; the id map is built on first use
+   */
+  rowOf(id: string): number {
+    if (!this.rowById) {
+      this.rowById = new Map();
+      for (let row = 0; row < this.count; row++) this.rowById.set(this.id(row), row);
+    }
+    return this.rowById.get(id) ?? -1;
+  }
+
+  /**
+   * Materializes one row as a plain catalogue item
+   */
+  item(row: number): CatalogueItem {
+    const p = row * 3;
+    const description = this.description(row);
+    const modelUrl = this.modelUrl(row);
+    return {
+      id: this.id(row),
+      name: this.name(row),
+      category: this.category(row),
+      position: {
+        x: fromFloat32(this.positions[p]),
+        y: fromFloat32(this.positions[p + 1]),
+        z: fromFloat32(this.positions[p + 2]),
+      },
+      dimensions: {
+        width: fromFloat32(this.dimensions[p]),
+        height: fromFloat32(this.dimensions[p + 1]),
+        depth: fromFloat32(this.dimensions[p + 2]),
+      },
+      color: { r: this.colors[p], g: this.colors[p + 1], b: this.colors[p + 2] },
+      confidenceScore: fromFloat32(this.confidence[row]),
+      ...(description !== undefined && { description }),
+      ...(modelUrl !== undefined && { modelUrl }),
+    };
+  }
+
+  /**
+   * The text fields the embedding needs, without materializing the row
+   */
+  embeddingFields(row: number) {
+    return {
+      name: this.name(row),
+      category: this.category(row),
+      description: this.description(row),
+      confidenceScore: this.confidence[row],
+    };
+  }
+
+  private string(ref: number): string | undefined {
+    if (ref === NO_STRING) return undefined;
+    let text = this.strings[ref];
+    if (text === undefined) {
+      text = decoder.decode(this.stringData.subarray(this.stringOffsets[ref], this.stringOffsets[ref + 1]));
+      this.strings[ref] = text;
+    }
+    return text;
+  }
+}
@@ -0,0 +1,81 @@
+import { Furniture } from '@/types/furniture';
+import { JAPANESE_FURNITURE_DATABASE, MOCK_FURNITURE_DATABASE } from './furnitureData';
+import { fnv1a } from './embedding';
+
+/**
+ * Versioned catalogue manifest (server only)
+ *
+ * The catalogue is split into shards, one per furniture database. Every
+ * entry carries a content hash as its version, so clients holding an older
+ * copy re-download only the entries whose hash changed. The manifest
+ * version hashes all entry versions and doubles as its ETag.
+ */
+
+export type CatalogueItem = Omit<Furniture, 'visible'>;
+
+export interface CatalogueManifestEntry {
+  id: string;
+  version: string;
+}
+
+export interface CatalogueShardManifest {
+  shard: string;
+  version: string;
+  entries: CatalogueManifestEntry[];
+}
+
+export interface CatalogueManifest {
+  version: string;
+  shards: CatalogueShardManifest[];
+}
+
+export interface CatalogueEntriesResponse {
+  shard: string;
+  entries: (CatalogueManifestEntry & { item: CatalogueItem })[];
+}
+
+export const CATALOGUE_SHARDS: Record<string, CatalogueItem[]> = {
+  default: MOCK_FURNITURE_DATABASE,
+  japanese: JAPANESE_FURNITURE_DATABASE,
+};
+
+const hashVersion = (text: string) => fnv1a(text).toString(36);
+
+let manifest: CatalogueManifest | null = null;
+
+/**
+ * Builds the manifest once; the catalogue is static for the server's lifetime
+ */
+export function getCatalogueManifest(): CatalogueManifest {
+  if (manifest) return manifest;
+
+  const shards = Object.entries(CATALOGUE_SHARDS).map(([shard, items]) => {
+    const entries = items.map(item => ({ id: item.id, version: hashVersion(JSON.stringify(item)) }));
+    return {
+      shard,
+      version: hashVersion(entries.map(entry => `${entry.id}@${entry.version}`).join(',')),
+      entries,
+    };
+  });
+  manifest = {
+    version: hashVersion(shards.map(shard => `${shard.shard}@${shard.version}`).join(',')),
+    shards,
+  };
+  return manifest;
+}
+
+/**
+ * Entries of one shard, limited to `ids` when given
+ * Returns null for an unknown shard
+ */
+export function getCatalogueEntries(shard: string, ids?: string[]): CatalogueEntriesResponse | null {
+  const items = CATALOGUE_SHARDS[shard];
+  const shardManifest = getCatalogueManifest().shards.find(entry => entry.shard === shard);
+  if (!items || !shardManifest) return null;
+
+  const wanted = ids ? new Set(ids) : null;
+  const entries = items.flatMap((item, index) =>
+    wanted && !wanted.has(item.id) ? [] : [{ ...shardManifest.entries[index], item }]
+  );
+  return { shard, entries };
+}
@@ -0,0 +1,165 @@
+import type {
+  CatalogueEntriesResponse,
+  CatalogueItem,
+  CatalogueManifest,
+  CatalogueShardManifest,
+} from './catalogueManifest';
+import { IdbStore } from './idbCache';
+import { throwIfAborted } from './retrievalBackend';
+
+/**
+ * Client copy of the furniture catalogue, kept in IndexedDB
+ *
+ * On sync the client fetches the small manifest, compares entry versions
+ * with what it stored last time and downloads only the entries that were
+ * added or changed. Unchanged shards cost one conditional request. When the
+ * network is unavailable the stored copy is used as is.
+ */
+
+export const CATALOGUE_ENDPOINT = '/api/catalogue';
+
+interface StoredEntry {
+  version: string;
+  item: CatalogueItem;
+}
+
+interface StoredShard {
+  version: string;
+  entries: { id: string; version: string }[];
+}
+
+const entryStore = new IdbStore<StoredEntry>('catalogue');
+const metaStore = new IdbStore<StoredShard>('meta');
+const shardListStore = new IdbStore<string[]>('meta');
+const SHARD_LIST_KEY = 'shards';
+
+interface StoredCatalogueShard {
+  shard: string;
+  version: string;
+  items: CatalogueItem[];
+}
+
+const entryKey = (shard: string, id: string) => `${shard}/${id}`;
+const shardKey = (shard: string) => `shard:${shard}`;
+
+// Synced shards, available synchronously once sync has run
+const syncedShards = new Map<string, CatalogueItem[]>();
+const syncedVersions = new Map<string, string>();
+
+/**
+ * Items of a shard from the last sync, if any
+ */
+export function getSyncedShard(shard: string): CatalogueItem[] | undefined {
+  return syncedShards.get(shard);
+}
+
+/**
+ * Manifest version of a synced shard, if any
+ */
+export function getSyncedShardVersion(shard: string): string | undefined {
+  return syncedVersions.get(shard);
+}
+
+async function readStoredShard(shard: string): Promise<CatalogueItem[] | null> {
+  const stored = await metaStore.get(shardKey(shard));
+  if (!stored) return null;
+  const entries = await entryStore.getMany(stored.entries.map(entry => entryKey(shard, entry.id)));
+  if (entries.some(entry => !entry)) return null; // Partially evicted
+  return entries.map(entry => entry!.item);
+}
+
+async function syncShard(
+  manifest: CatalogueManifest,
+  shardManifest: CatalogueShardManifest,
+  signal?: AbortSignal
+): Promise<CatalogueItem[]> {
+  const { shard } = shardManifest;
+  const stored = await metaStore.get(shardKey(shard));
+
+  if (stored?.version === shardManifest.version) {
+    const items = await readStoredShard(shard);
+    if (items) return items;
+  }
+
+  // Only entries missing from the store (never fetched or evicted) or at another version are downloaded
+  const present = await entryStore.getMany(shardManifest.entries.map(entry => entryKey(shard, entry.id)));
+  const changedIds = shardManifest.entries
+    .filter((entry, k) => present[k]?.version !== entry.version)
+    .map(entry => entry.id);
+
+  if (changedIds.length > 0) {
+    const params = new URLSearchParams({ shard, ids: changedIds.join(','), v: manifest.version });
+    const response = await fetch(`${CATALOGUE_ENDPOINT}?${params}`, { signal });
+    if (!response.ok) throw new Error(`Catalogue entries failed with status ${response.status}`);
+    const body = (await response.json()) as CatalogueEntriesResponse;
+    await entryStore.putMany(
+      body.entries.map(({ id, version, item }) => [entryKey(shard, id), { version, item }])
+    );
+  }
+
+  const current = new Set(shardManifest.entries.map(entry => entry.id));
+  const removed = (stored?.entries ?? []).filter(entry => !current.has(entry.id));
+  if (removed.length > 0) {
+    await entryStore.deleteMany(removed.map(entry => entryKey(shard, entry.id)));
+  }
+
+  await metaStore.put(shardKey(shard), {
+    version: shardManifest.version,
+    entries: shardManifest.entries,
+  });
+
+  const items = await readStoredShard(shard);
+  if (!items) throw new Error(`Catalogue shard "${shard}" is incomplete after sync`);
+  return items;
+}
+
+/**
+ * Every complete shard stored by the last sync
+ */
+async function readStoredShards(): Promise<StoredCatalogueShard[]> {
+  const shards = (await shardListStore.get(SHARD_LIST_KEY)) ?? [];
+  const stored: StoredCatalogueShard[] = [];
+  for (const shard of shards) {
+    const items = await readStoredShard(shard);
+    const meta = await metaStore.get(shardKey(shard));
+    if (items && meta) stored.push({ shard, version: meta.version, items });
+  }
+  return stored;
+}
+
+/**
+ * Items per shard as stored by the last sync, read without the network
+ * Empty before the first sync
+ */
+export async function readStoredCatalogue(): Promise<Map<string, CatalogueItem[]>> {
+  return new Map((await readStoredShards()).map(({ shard, items }) => [shard, items]));
+}
+
+/**
+ * Brings the local catalogue up to date; returns items per shard
+ * Falls back to the stored copy when the manifest cannot be fetched
+ */
+export async function syncCatalogue(signal?: AbortSignal): Promise<Map<string, CatalogueItem[]>> {
+  let manifest: CatalogueManifest;
+  try {
+    const response = await fetch(CATALOGUE_ENDPOINT, { signal, cache: 'no-cache' });
+    if (!response.ok) throw new Error(`Catalogue manifest failed with status ${response.status}`);
+    manifest = (await response.json()) as CatalogueManifest;
+  } catch (error) {
+    throwIfAborted(signal);
+    console.warn('Catalogue manifest unavailable, using stored copy:', error);
+    for (const { shard, version, items } of await readStoredShards()) {
+      syncedShards.set(shard, items);
+      syncedVersions.set(shard, version);
+    }
+    return syncedShards;
+  }
+
+  for (const shardManifest of manifest.shards) {
+    throwIfAborted(signal);
+    syncedShards.set(shardManifest.shard, await syncShard(manifest, shardManifest, signal));
+    syncedVersions.set(shardManifest.shard, shardManifest.version);
+  }
+  await shardListStore.put(SHARD_LIST_KEY, manifest.shards.map(shard => shard.shard));
+  return syncedShards;
+}
@@ -0,0 +1,114 @@
+import { ChatMessage } from '@/types/chat';
+import { nextFrame } from './scheduling';
+
+/**
+ * Incremental assistant replies
+ *
+ * The reply is a ReadableStream of text chunks. The page writes to it as
+ * soon as it knows something (the detected style right away, the summary
+ * once retrieval finishes), so the first tokens show up without waiting
+ * for the whole retrieval. A model-backed reply would plug in the same way.
+ */
+
+/**
+ * Writable end of a reply stream
+ */
+export interface TextChannel {
+  readable: ReadableStream<string>;
+  write(text: string): void;
+  close(): void;
+}
+
+/**
+ * Creates a reply stream together with its writer
+ * Writes after `close` are ignored
+ */
+export function createTextChannel(): TextChannel {
+  let controller: ReadableStreamDefaultController<string> | null = null;
+  let closed = false;
+
+  const readable = new ReadableStream<string>({
+    start(streamController) {
+      controller = streamController;
+    },
+  });
+
+  return {
+    readable,
+    write(text) {
+      if (!closed && text) controller?.enqueue(text);
+    },
+    close() {
+      if (closed) return;
+      closed = true;
+      controller?.close();
+    },
+  };
+}
+
+/**
+ * Calls `onAppend` with the text received since the previous call, at most
+ * once per animation frame, until the stream ends
+ */
+export async function pipeTextStream(
+  readable: ReadableStream<string>,
+  onAppend: (text: string) => void
+): Promise<void> {
+  const reader = readable.getReader();
+  let pending = '';
+  let cancelFrame = null as (() => void) | null;
+
+  const flush = () => {
+    cancelFrame = null;
+    if (pending) {
+      const text = pending;
+      pending = '';
+      onAppend(text);
+    }
+  };
+
+  while (true) {
+    const { done, value } = await reader.read();
+    if (done) break;
+    pending += value;
+    if (!cancelFrame) cancelFrame = nextFrame(flush);
+  }
+
+  cancelFrame?.();
+  flush();
+}
+
+/**
+ * Writes `text` word by word, the way a token stream would arrive
+ */
+export function writeWords(channel: TextChannel, text: string) {
+  const words = text.match(/\S+\s*|\s+/g) ?? [];
+  words.forEach(word => channel.write(word));
+}
+
+/**
+ * Appends `text` to one message, reusing every other message object so that
+ * memoized rows for the rest of the conversation skip re-rendering
+ */
+export function appendToMessage(messages: ChatMessage[], id: string, text: string): ChatMessage[] {
+  // Streaming messages are almost always last, so search from the end
+  for (let i = messages.length - 1; i >= 0; i--) {
+    if (messages[i].id === id) {
+      const next = messages.slice();
+      next[i] = { ...messages[i], content: messages[i].content + text };
+      return next;
+    }
+  }
+  return messages;
+}
+
+/**
+ * Marks a streamed message as complete
+ */
+export function finishMessage(messages: ChatMessage[], id: string): ChatMessage[] {
+  const index = messages.findIndex(message => message.id === id);
+  if (index === -1 || !messages[index].streaming) return messages;
+  const next = messages.slice();
+  next[index] = { ...messages[index], streaming: false };
+  return next;
+}
@@ -0,0 +1,292 @@
+import * as THREE from 'three';
+import { Furniture } from '@/types/furniture';
+import { Rect, SpatialGrid, footprintRect } from './spatialIndex';
+import { ROOM_DEPTH, ROOM_HEIGHT, ROOM_WIDTH } from './roomStats';
+
+/**
+ * Per-room visibility and frustum culling for furniture
+ *
+ * A floor plan is a set of rooms (axis-aligned cells on the floor) joined
+ * by portals (door openings in a shared wall). Culling runs in two passes:
+ *
+ * 1. Rooms. With the camera inside a room, below its walls, only rooms
+ *    reachable through portals the camera can see are visible; walls hide
+ *    the rest. From outside or above the walls, every room the frustum
+ *    touches is visible. Portals are not used to narrow the frustum, so
+ *    this errs towards drawing too much, never too little.
+ * 2. Furniture. The footprint grid is queried with each visible room,
+ *    clipped to the frustum's floor footprint, and only those candidates
+ *    are tested against the frustum.
+ *
+ * Everything is recomputed only when the camera or the furniture changes.
+ */
+
+export interface RoomCell {
+  id: string;
+  bounds: Rect;
+  height: number; // Wall height
+}
+
+export interface Portal {
+  rooms: [string, string];
+  opening: Rect; // Footprint of the doorway, straddling the shared wall
+  height: number;
+}
+
+/**
+ * The demo's single room
+ */
+export const DEFAULT_ROOMS: RoomCell[] = [
+  {
+    id: 'main',
+    bounds: { minX: -ROOM_WIDTH / 2, minZ: -ROOM_DEPTH / 2, maxX: ROOM_WIDTH / 2, maxZ: ROOM_DEPTH / 2 },
+    height: ROOM_HEIGHT,
+  },
+];
+
+// Items are tested with a little slack so their shadows and edges do not
+// pop in at the frustum border
+const CULL_MARGIN = 0.25;
+
+const EMPTY: ReadonlySet<string> = new Set();
+
+/**
+ * Layer culled furniture is moved to
+ * The main camera does not draw it, but the key light's shadow pass does
+ * (see SceneShadows), so culled items keep casting shadows into view
+ */
+export const CULLED_LAYER = 1;
+
+/**
+ * Moves every object under `root` to CULLED_LAYER, or back to the default layer
+ */
+export function applyCulledLayer(root: THREE.Object3D, culled: boolean) {
+  root.traverse(object => object.layers.set(culled ? CULLED_LAYER : 0));
+}
+
+function containsPoint(rect: Rect, x: number, z: number): boolean {
+  return x >= rect.minX && x <= rect.maxX && z >= rect.minZ && z <= rect.maxZ;
+}
+
+function intersectRects(a: Rect, b: Rect): Rect | null {
+  const rect = {
+    minX: Math.max(a.minX, b.minX),
+    minZ: Math.max(a.minZ, b.minZ),
+    maxX: Math.min(a.maxX, b.maxX),
+    maxZ: Math.min(a.maxZ, b.maxZ),
+  };
+  return rect.minX <= rect.maxX && rect.minZ <= rect.maxZ ? rect : null;
+}
+
+function setBox(box: THREE.Box3, rect: Rect, minY: number, maxY: number): THREE.Box3 {
+  box.min.set(rect.minX, minY, rect.minZ);
+  box.max.set(rect.maxX, maxY, rect.maxZ);
+  return box;
+}
+
+function sameSet(a: ReadonlySet<string>, b: ReadonlySet<string>): boolean {
+  if (a.size !== b.size) return false;
+  for (const id of a) if (!b.has(id)) return false;
+  return true;
+}
+
+const scratchBox = new THREE.Box3();
+const scratchMatrix = new THREE.Matrix4();
+const scratchNear = new THREE.Vector3();
+const scratchFar = new THREE.Vector3();
+const NDC_CORNERS = [
+  [-1, -1],
+  [1, -1],
+  [-1, 1],
+  [1, 1],
+];
+
+/**
+ * Tracks which rooms and furniture the camera can see
+ */
+export class SceneCuller {
+  private readonly grid = new SpatialGrid();
+  private readonly furniture = new Map<string, Furniture>();
+  // Items outside every room; only the frustum test applies to them
+  private outside: Furniture[] = [];
+  private readonly roomById: Map<string, RoomCell>;
+  private readonly neighbours = new Map<string, Portal[]>();
+  private readonly frustum = new THREE.Frustum();
+  private readonly lastView = new THREE.Matrix4();
+  private readonly lastProjection = new THREE.Matrix4();
+  private readonly bounds: Rect;
+  private dirty = true;
+
+  /** Rooms visible from the camera at the last update; a new set only when it changes */
+  visibleRooms: ReadonlySet<string> = EMPTY;
+  /** Furniture ids left out of the last update; a new set only when it changes */
+  culled: ReadonlySet<string> = EMPTY;
+
+  constructor(private readonly rooms: RoomCell[] = DEFAULT_ROOMS, portals: Portal[] = []) {
+    this.roomById = new Map(rooms.map(room => [room.id, room]));
+    // Every room counts as visible until the first update
+    this.visibleRooms = new Set(this.roomById.keys());
+    portals.forEach(portal => {
+      portal.rooms.forEach(id => {
+        const list = this.neighbours.get(id) ?? [];
+        list.push(portal);
+        this.neighbours.set(id, list);
+      });
+    });
+    this.bounds = rooms.reduce<Rect>(
+      (all, room) => ({
+        minX: Math.min(all.minX, room.bounds.minX),
+        minZ: Math.min(all.minZ, room.bounds.minZ),
+        maxX: Math.max(all.maxX, room.bounds.maxX),
+        maxZ: Math.max(all.maxZ, room.bounds.maxZ),
+      }),
+      { minX: Infinity, minZ: Infinity, maxX: -Infinity, maxZ: -Infinity }
+    );
+  }
+
+  /**
+   * Replaces the furniture being culled
+   */
+  setFurniture(furniture: Furniture[]) {
+    this.grid.clear();
+    this.furniture.clear();
+    this.outside = [];
+    furniture.forEach(item => {
+      const rect = footprintRect(item);
+      this.furniture.set(item.id, item);
+      this.grid.insert(item.id, rect);
+      if (!this.rooms.some(room => intersectRects(room.bounds, rect))) this.outside.push(item);
+    });
+    this.dirty = true;
+  }
+
+  /**
+   * Recomputes visibility for `camera` if it or the furniture changed;
+   * returns true when the visible rooms or the culled set changed
+   */
+  update(camera: THREE.Camera): boolean {
+    // Controls move the camera earlier in the frame; its matrices catch up
+    // only when the scene renders
+    camera.updateMatrixWorld();
+    if (
+      !this.dirty &&
+      this.lastView.equals(camera.matrixWorldInverse) &&
+      this.lastProjection.equals(camera.projectionMatrix)
+    ) {
+      return false;
+    }
+    this.dirty = false;
+    this.lastView.copy(camera.matrixWorldInverse);
+    this.lastProjection.copy(camera.projectionMatrix);
+
+    this.frustum.setFromProjectionMatrix(
+      scratchMatrix.multiplyMatrices(camera.projectionMatrix, camera.matrixWorldInverse)
+    );
+    const visibleRooms = this.findVisibleRooms(camera.position);
+    const roomsChanged = !sameSet(visibleRooms, this.visibleRooms);
+    if (roomsChanged) this.visibleRooms = visibleRooms;
+
+    const footprint = this.frustumFootprint(camera);
+    const visible = new Set<string>();
+    visibleRooms.forEach(id => {
+      const area = footprint && intersectRects(this.roomById.get(id)!.bounds, footprint);
+      if (!area) return;
+      this.grid.query(area).forEach(itemId => {
+        if (!visible.has(itemId) && this.inFrustum(this.furniture.get(itemId)!)) visible.add(itemId);
+      });
+    });
+    this.outside.forEach(item => {
+      if (this.inFrustum(item)) visible.add(item.id);
+    });
+
+    const culled = new Set<string>();
+    this.furniture.forEach((item, id) => {
+      if (!visible.has(id)) culled.add(id);
+    });
+    if (sameSet(culled, this.culled)) return roomsChanged;
+    this.culled = culled.size === 0 ? EMPTY : culled;
+    return true;
+  }
+
+  private roomAt(position: THREE.Vector3): RoomCell | undefined {
+    return this.rooms.find(
+      room => position.y < room.height && containsPoint(room.bounds, position.x, position.z)
+    );
+  }
+
+  private roomInFrustum(room: RoomCell): boolean {
+    return this.frustum.intersectsBox(setBox(scratchBox, room.bounds, 0, room.height));
+  }
+
+  /**
+   * Rooms the camera can see: flood fill through visible portals from the
+   * camera's room, or every room in the frustum from outside
+   */
+  private findVisibleRooms(position: THREE.Vector3): ReadonlySet<string> {
+    const start = this.roomAt(position);
+    if (!start) {
+      return new Set(this.rooms.filter(room => this.roomInFrustum(room)).map(room => room.id));
+    }
+
+    const visible = new Set([start.id]);
+    const queue = [start.id];
+    while (queue.length > 0) {
+      const id = queue.pop()!;
+      this.neighbours.get(id)?.forEach(portal => {
+        const next = portal.rooms[0] === id ? portal.rooms[1] : portal.rooms[0];
+        if (visible.has(next)) return;
+        if (!this.frustum.intersectsBox(setBox(scratchBox, portal.opening, 0, portal.height))) return;
+        visible.add(next);
+        queue.push(next);
+      });
+    }
+    return visible;
+  }
+
+  /**
+   * Floor-plane bounding rectangle of the frustum, cut off where it leaves
+   * the floor plan; null when the camera faces away from it
+   */
+  private frustumFootprint(camera: THREE.Camera): Rect | null {
+    const { bounds } = this;
+    if (!Number.isFinite(bounds.minX)) return null;
+
+    // Nothing in the plan is further away than its farthest corner
+    const reach = Math.max(
+      ...[bounds.minX, bounds.maxX].flatMap(x =>
+        [bounds.minZ, bounds.maxZ].map(z => Math.hypot(x - camera.position.x, z - camera.position.z))
+      )
+    ) + Math.abs(camera.position.y) + ROOM_HEIGHT;
+
+    const rect = { minX: Infinity, minZ: Infinity, maxX: -Infinity, maxZ: -Infinity };
+    const extend = (point: THREE.Vector3) => {
+      rect.minX = Math.min(rect.minX, point.x);
+      rect.minZ = Math.min(rect.minZ, point.z);
+      rect.maxX = Math.max(rect.maxX, point.x);
+      rect.maxZ = Math.max(rect.maxZ, point.z);
+    };
+
+    NDC_CORNERS.forEach(([x, y]) => {
+      // View-space points on the near and far planes; depth is linear along
+      // the edge, so the point `reach` deep is a lerp between them
+      scratchNear.set(x, y, -1).applyMatrix4(camera.projectionMatrixInverse);
+      scratchFar.set(x, y, 1).applyMatrix4(camera.projectionMatrixInverse);
+      const nearDepth = -scratchNear.z;
+      const farDepth = -scratchFar.z;
+      const t = farDepth > reach ? (reach - nearDepth) / (farDepth - nearDepth) : 1;
+      scratchFar.lerpVectors(scratchNear, scratchFar, Math.max(t, 0));
+      extend(scratchNear.applyMatrix4(camera.matrixWorld));
+      extend(scratchFar.applyMatrix4(camera.matrixWorld));
+    });
+
+    return intersectRects(bounds, rect);
+  }
+
+  private inFrustum(item: Furniture): boolean {
+    const rect = footprintRect(item);
+    const halfHeight = item.dimensions.height / 2;
+    scratchBox.min.set(rect.minX, item.position.y - halfHeight, rect.minZ);
+    scratchBox.max.set(rect.maxX, item.position.y + halfHeight, rect.maxZ);
+    return this.frustum.intersectsBox(scratchBox.expandByScalar(CULL_MARGIN));
+  }
+}
@@ -0,0 +1,137 @@
+import { Furniture } from '@/types/furniture';
+import type { CatalogueItem } from './catalogueManifest';
+
+/**
+ * Compact binary encoding of a design as deltas from the catalogue
+ *
+ * A design only ever changes where items stand on the floor, which way they
+ * face and whether they are shown; everything else comes from the catalogue
+ * entry with the same id. So each item is stored as its id, a flag byte
+ * and, only when the layout moved it, its x and z:
+ *
+ *   header      u32 × 4   magic, format version, items, moved items
+ *   positions   f32 × 2m  x, z of moved items, in item order
+ *   id offsets  u32 × (n + 1), into the id bytes
+ *   flags       u8 × n    bit 0 visible, bit 1 moved, bits 2-3 quarter turns
+ *   id bytes    utf8
+ *
+ * A 500-item design is a few kilobytes, and decoding is a single pass over
+ * typed arrays.
+ */
+
+const MAGIC = 0x53444344; // 'DCDS'
+const FORMAT_VERSION = 2; // 1 had no turns; its designs decode unturned
+const HEADER_WORDS = 4;
+
+const VISIBLE = 1;
+const MOVED = 2;
+const TURNS_SHIFT = 2;
+const QUARTER_TURN = Math.PI / 2;
+
+const encoder = new TextEncoder();
+const decoder = new TextDecoder();
+
+/**
+ * Encodes `furniture` relative to its catalogue entries
+ * Items missing from the catalogue cannot be restored and are left out
+ */
+export function encodeDesign(
+  furniture: Furniture[],
+  baseline: (id: string) => CatalogueItem | undefined
+): ArrayBuffer {
+  const items = furniture.filter(item => baseline(item.id));
+  const count = items.length;
+
+  const flags = new Uint8Array(count);
+  const moved: number[] = [];
+  items.forEach((item, i) => {
+    const base = baseline(item.id)!;
+    // Compare at Float32 precision, the precision positions are stored in
+    const changed =
+      Math.fround(item.position.x) !== Math.fround(base.position.x) ||
+      Math.fround(item.position.z) !== Math.fround(base.position.z);
+    const turns = Math.round((item.rotationY ?? 0) / QUARTER_TURN) & 3;
+    flags[i] = (item.visible ? VISIBLE : 0) | (changed ? MOVED : 0) | (turns << TURNS_SHIFT);
+    if (changed) moved.push(item.position.x, item.position.z);
+  });
+
+  const idBytes = items.map(item => encoder.encode(item.id));
+  const idLength = idBytes.reduce((total, bytes) => total + bytes.length, 0);
+
+  const movedCount = moved.length / 2;
+  const wordCount = HEADER_WORDS + moved.length + count + 1;
+  const buffer = new ArrayBuffer(wordCount * 4 + count + idLength);
+
+  let offset = 0;
+  const header = new Uint32Array(buffer, offset, HEADER_WORDS);
+  header.set([MAGIC, FORMAT_VERSION, count, movedCount]);
+  offset += HEADER_WORDS * 4;
+
+  new Float32Array(buffer, offset, moved.length).set(moved);
+  offset += moved.length * 4;
+
+  const idOffsets = new Uint32Array(buffer, offset, count + 1);
+  offset += (count + 1) * 4;
+
+  new Uint8Array(buffer, offset, count).set(flags);
+  offset += count;
+
+  const idData = new Uint8Array(buffer, offset, idLength);
+  let byte = 0;
+  idBytes.forEach((bytes, i) => {
+    idOffsets[i] = byte;
+    idData.set(bytes, byte);
+    byte += bytes.length;
+  });
+  idOffsets[count] = byte;
+
+  return buffer;
+}
+
+/**
+ * Rebuilds furniture from an encoded design and the catalogue
+ * Items that have since left the catalogue are skipped
+ */
+export function decodeDesign(
+  buffer: ArrayBuffer,
+  baseline: (id: string) => CatalogueItem | undefined
+): Furniture[] {
+  const [magic, version, count, movedCount] = new Uint32Array(buffer, 0, HEADER_WORDS);
+  if (magic !== MAGIC) throw new Error('Not an encoded design');
+  if (version !== FORMAT_VERSION && version !== 1) throw new Error(`Unsupported design format version ${version}`);
+
+  let offset = HEADER_WORDS * 4;
+  const positions = new Float32Array(buffer, offset, movedCount * 2);
+  offset += movedCount * 8;
+  const idOffsets = new Uint32Array(buffer, offset, count + 1);
+  offset += (count + 1) * 4;
+  const flags = new Uint8Array(buffer, offset, count);
+  offset += count;
+  const idData = new Uint8Array(buffer, offset);
+
+  const furniture: Furniture[] = [];
+  let movedIndex = 0;
+  for (let i = 0; i < count; i++) {
+    const id = decoder.decode(idData.subarray(idOffsets[i], idOffsets[i + 1]));
+    const flag = flags[i];
+    const base = baseline(id);
+    let x = 0;
+    let z = 0;
+    if (flag & MOVED) {
+      x = positions[movedIndex * 2];
+      z = positions[movedIndex * 2 + 1];
+      movedIndex++;
+    }
+    if (!base) continue;
+    const turns = (flag >> TURNS_SHIFT) & 3;
+    const item: Furniture = {
+      ...base,
+      position: flag & MOVED ? { ...base.position, x, z } : base.position,
+      visible: (flag & VISIBLE) !== 0,
+    };
+    if (turns !== 0) item.rotationY = turns * QUARTER_TURN;
+    furniture.push(item);
+  }
+  return furniture;
+}
+
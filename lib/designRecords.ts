@@ -0,0 +1,97 @@
+import type { DesignList, DesignRecord } from './designStore';
+import { LRUCache } from './lruCache';
+
+/**
+ * In-memory design records for the sync routes (server only)
+ * Enough for the demo; a deployment would back this with a database.
+ *
+ * Records are scoped by the caller's sync key, an unguessable bearer token
+ * each browser creates for itself: a key reaches only the designs saved
+ * under it, so one client can neither list nor overwrite another's. Deletes
+ * leave a tombstone that other copies of the design sync against.
+ */
+
+// Oldest designs, and oldest tombstones, are dropped past this per key
+const MAX_DESIGNS = 200;
+// Least recently used keys are dropped past this
+const MAX_OWNERS = 1_000;
+
+const SYNC_KEY = /^[\w-]{16,128}$/;
+
+interface OwnerRecords {
+  designs: Map<string, DesignRecord>;
+  deleted: Map<string, number>; // Design id to deletedAt
+}
+
+const owners = new LRUCache<string, OwnerRecords>({ maxEntries: MAX_OWNERS });
+
+/**
+ * The sync key a request is made with, or null without a valid one
+ */
+export function designOwner(request: Request): string | null {
+  const key = request.headers.get('authorization')?.match(/^Bearer (.+)$/)?.[1];
+  return key && SYNC_KEY.test(key) ? key : null;
+}
+
+/**
+ * 401 response for requests without a sync key
+ */
+export function missingSyncKey(): Response {
+  return Response.json(
+    { error: 'A design sync key is required' },
+    { status: 401, headers: { 'WWW-Authenticate': 'Bearer' } }
+  );
+}
+
+function recordsOf(owner: string): OwnerRecords {
+  let records = owners.get(owner);
+  if (!records) {
+    records = { designs: new Map(), deleted: new Map() };
+    owners.set(owner, records);
+  }
+  return records;
+}
+
+// Re-inserting keeps a map in save order, so the oldest entry comes first
+function insertBounded<V>(map: Map<string, V>, key: string, value: V) {
+  map.delete(key);
+  map.set(key, value);
+  while (map.size > MAX_DESIGNS) map.delete(map.keys().next().value!);
+}
+
+export function getDesignRecord(owner: string, id: string): DesignRecord | undefined {
+  return owners.get(owner)?.designs.get(id);
+}
+
+/**
+ * When `id` was deleted under `owner`, if it was
+ */
+export function designDeletedAt(owner: string, id: string): number | undefined {
+  return owners.get(owner)?.deleted.get(id);
+}
+
+export function putDesignRecord(owner: string, record: DesignRecord) {
+  const { designs, deleted } = recordsOf(owner);
+  deleted.delete(record.id); // Saved again after the delete
+  insertBounded(designs, record.id, record);
+}
+
+export function deleteDesignRecord(owner: string, id: string, deletedAt: number) {
+  const { designs, deleted } = recordsOf(owner);
+  designs.delete(id);
+  insertBounded(deleted, id, Math.max(deletedAt, deleted.get(id) ?? -Infinity));
+}
+
+/**
+ * Summaries of an owner's designs, newest first, and their tombstones
+ */
+export function listDesigns(owner: string): DesignList {
+  const records = owners.get(owner);
+  if (!records) return { designs: [], deleted: [] };
+  return {
+    designs: [...records.designs.values()]
+      .map(({ id, name, savedAt, itemCount }) => ({ id, name, savedAt, itemCount }))
+      .sort((a, b) => b.savedAt - a.savedAt),
+    deleted: [...records.deleted].map(([id, deletedAt]) => ({ id, deletedAt })),
+  };
+}
@@ -0,0 +1,340 @@
+import { Furniture } from '@/types/furniture';
+import { ChatMessage } from '@/types/chat';
+import type { CatalogueItem } from './catalogueManifest';
+import { readStoredCatalogue, syncCatalogue } from './catalogueSync';
+import { decodeDesign, encodeDesign } from './designCodec';
+import { IdbStore } from './idbCache';
+import { throwIfAborted } from './retrievalBackend';
+
+/**
+ * Saved designs, local first
+ *
+ * A design is the room's furniture, encoded as deltas from the catalogue
+ * (see lib/designCodec.ts), plus the chat that produced it. Designs are
+ * kept in IndexedDB, with a small list of summaries beside them so the
+ * picker never reads the deltas. When NEXT_PUBLIC_DESIGN_SYNC_ENDPOINT is
+ * set, saves and deletes are also sent to the server and `syncDesigns`
+ * pulls designs saved under the same sync key elsewhere; the server is
+ * never needed to save or restore. Deletes leave a tombstone on both
+ * sides, so a sync never brings a deleted design back.
+ */
+
+export const DESIGN_SYNC_ENDPOINT = process.env.NEXT_PUBLIC_DESIGN_SYNC_ENDPOINT ?? '';
+
+export interface DesignSummary {
+  id: string;
+  name: string;
+  savedAt: number; // Epoch milliseconds
+  itemCount: number;
+}
+
+/**
+ * Marks a deleted design; copies saved before `deletedAt` stay deleted
+ */
+export interface DesignTombstone {
+  id: string;
+  deletedAt: number; // Epoch milliseconds
+}
+
+/**
+ * The sync endpoint's listing: live designs and recent deletes
+ */
+export interface DesignList {
+  designs: DesignSummary[];
+  deleted: DesignTombstone[];
+}
+
+export interface SavedMessage {
+  id: string;
+  role: ChatMessage['role'];
+  content: string;
+  timestamp: number;
+}
+
+interface StoredDesign extends DesignSummary {
+  delta: ArrayBuffer;
+  messages: SavedMessage[];
+}
+
+/**
+ * A design as sent to and from the sync endpoint; the delta is base64
+ */
+export interface DesignRecord extends DesignSummary {
+  delta: string;
+  messages: SavedMessage[];
+}
+
+export interface RestoredDesign {
+  summary: DesignSummary;
+  furniture: Furniture[];
+  messages: ChatMessage[];
+}
+
+const designStore = new IdbStore<StoredDesign>('designs');
+const summaryStore = new IdbStore<DesignSummary[]>('meta');
+const tombstoneStore = new IdbStore<DesignTombstone[]>('meta');
+const SUMMARIES_KEY = 'designs';
+const TOMBSTONES_KEY = 'designTombstones';
+
+// Oldest tombstones are forgotten past this
+const MAX_TOMBSTONES = 200;
+
+// localStorage entry holding this browser's sync key (see lib/designRecords.ts)
+const SYNC_KEY_STORAGE = 'decoplan-design-sync-key';
+
+// Browsers reject keepalive requests whose bodies add up to more than this
+const KEEPALIVE_LIMIT = 64 * 1024;
+
+type Baseline = Map<string, CatalogueItem>;
+
+const toBaseline = (shards: Map<string, CatalogueItem[]>): Baseline =>
+  new Map([...shards.values()].flat().map(item => [item.id, item]));
+
+// Catalogue items by id, from every synced shard
+let baselineReady: Promise<Baseline> | null = null;
+let syncedBaseline: Baseline | null = null;
+// The same from the copy the last sync stored, for restores before sync
+let storedBaseline: Promise<Baseline> | null = null;
+
+/**
+ * The catalogue the deltas are relative to; synced once per page
+ */
+function loadBaseline(): Promise<Baseline> {
+  baselineReady ??= syncCatalogue()
+    .then(shards => (syncedBaseline = toBaseline(shards)))
+    .catch(error => {
+      baselineReady = null;
+      throw error;
+    });
+  return baselineReady;
+}
+
+/**
+ * The catalogue to restore against: the synced one once it is in, and
+ * until then the copy stored by the last sync, which needs no network.
+ * Only a first visit, with nothing stored, waits for the sync.
+ */
+async function restoreBaseline(): Promise<Baseline> {
+  if (syncedBaseline) return syncedBaseline;
+  storedBaseline ??= readStoredCatalogue().then(toBaseline);
+  const stored = await storedBaseline;
+  return stored.size > 0 ? stored : loadBaseline();
+}
+
+/**
+ * Starts syncing the catalogue early, so the first restore only decodes
+ */
+export function prepareDesigns() {
+  loadBaseline().catch(error => console.warn('Catalogue unavailable for designs:', error));
+}
+
+async function readSummaries(): Promise<DesignSummary[]> {
+  return (await summaryStore.get(SUMMARIES_KEY)) ?? [];
+}
+
+async function readTombstones(): Promise<DesignTombstone[]> {
+  return (await tombstoneStore.get(TOMBSTONES_KEY)) ?? [];
+}
+
+/**
+ * Drops a design and its summary from IndexedDB
+ */
+async function removeLocalDesign(id: string) {
+  await designStore.deleteMany([id]);
+  await summaryStore.put(
+    SUMMARIES_KEY,
+    (await readSummaries()).filter(summary => summary.id !== id)
+  );
+}
+
+async function writeSummary(summary: DesignSummary) {
+  const summaries = (await readSummaries()).filter(entry => entry.id !== summary.id);
+  await summaryStore.put(
+    SUMMARIES_KEY,
+    [summary, ...summaries].sort((a, b) => b.savedAt - a.savedAt)
+  );
+}
+
+function toBase64(buffer: ArrayBuffer): string {
+  const bytes = new Uint8Array(buffer);
+  let binary = '';
+  // In chunks, so large designs do not overflow the argument list
+  for (let i = 0; i < bytes.length; i += 0x8000) {
+    binary += String.fromCharCode(...bytes.subarray(i, i + 0x8000));
+  }
+  return btoa(binary);
+}
+
+function fromBase64(text: string): ArrayBuffer {
+  const binary = atob(text);
+  const bytes = new Uint8Array(binary.length);
+  for (let i = 0; i < binary.length; i++) bytes[i] = binary.charCodeAt(i);
+  return bytes.buffer;
+}
+
+/**
+ * This browser's key for the sync endpoint, created on first use
+ * Designs synced under one key are invisible to every other key.
+ */
+function syncKey(): string {
+  let key = localStorage.getItem(SYNC_KEY_STORAGE);
+  if (!key) {
+    key = crypto.randomUUID();
+    localStorage.setItem(SYNC_KEY_STORAGE, key);
+  }
+  return key;
+}
+
+function syncFetch(path: string, init: RequestInit = {}): Promise<Response> {
+  const headers = new Headers(init.headers);
+  headers.set('Authorization', `Bearer ${syncKey()}`);
+  return fetch(`${DESIGN_SYNC_ENDPOINT}${path}`, { ...init, headers });
+}
+
+/**
+ * Sends a change to the sync endpoint; best-effort, the local copy stands
+ * Small bodies go as keepalive so they survive the tab closing; larger
+ * saves would be refused that way and are sent as a normal request
+ */
+function pushToServer(id: string, init: RequestInit) {
+  if (!DESIGN_SYNC_ENDPOINT) return;
+  const keepalive =
+    typeof init.body === 'string' && new TextEncoder().encode(init.body).length < KEEPALIVE_LIMIT;
+  syncFetch(`/${encodeURIComponent(id)}`, { ...init, keepalive })
+    .then(response => {
+      if (!response.ok) throw new Error(`Design sync failed with status ${response.status}`);
+    })
+    .catch(error => console.warn('Design sync failed:', error));
+}
+
+/**
+ * Saves the room and chat under `name`; saving with an existing id
+ * overwrites that design
+ */
+export async function saveDesign(
+  name: string,
+  furniture: Furniture[],
+  messages: ChatMessage[],
+  id: string = Date.now().toString(36)
+): Promise<DesignSummary> {
+  const baseline = await loadBaseline();
+  const delta = encodeDesign(furniture, itemId => baseline.get(itemId));
+  // Only items found in the catalogue are encoded
+  const itemCount = furniture.filter(item => baseline.has(item.id)).length;
+  const summary: DesignSummary = { id, name, savedAt: Date.now(), itemCount };
+  const design: StoredDesign = {
+    ...summary,
+    delta,
+    // Replies still streaming are saved as far as they got
+    messages: messages.map(message => ({
+      id: message.id,
+      role: message.role,
+      content: message.content,
+      timestamp: message.timestamp.getTime(),
+    })),
+  };
+
+  await designStore.put(id, design);
+  await writeSummary(summary);
+
+  const record: DesignRecord = { ...design, delta: toBase64(delta) };
+  pushToServer(id, {
+    method: 'PUT',
+    headers: { 'Content-Type': 'application/json' },
+    body: JSON.stringify(record),
+  });
+  return summary;
+}
+
+/**
+ * Saved designs, newest first
+ */
+export function listDesigns(): Promise<DesignSummary[]> {
+  return readSummaries();
+}
+
+/**
+ * Decodes a saved design against the catalogue
+ * Resolves to null when no design has that id. Decodes against the stored
+ * catalogue while the sync is still running, and only waits for the sync
+ * when the stored copy is missing some of the design's items.
+ */
+export async function loadDesign(id: string): Promise<RestoredDesign | null> {
+  const [design, baseline] = await Promise.all([designStore.get(id), restoreBaseline()]);
+  if (!design) return null;
+
+  const { delta, messages, ...summary } = design;
+  let furniture = decodeDesign(delta, itemId => baseline.get(itemId));
+  if (furniture.length < summary.itemCount && baseline !== syncedBaseline) {
+    const synced = await loadBaseline();
+    furniture = decodeDesign(delta, itemId => synced.get(itemId));
+  }
+  return {
+    summary: { ...summary, itemCount: furniture.length },
+    furniture,
+    messages: messages.map(message => ({ ...message, timestamp: new Date(message.timestamp) })),
+  };
+}
+
+/**
+ * Deletes a design here and on the sync endpoint, leaving a tombstone so
+ * a later sync does not pull it back
+ */
+export async function deleteDesign(id: string): Promise<void> {
+  const deletedAt = Date.now();
+  await removeLocalDesign(id);
+  const tombstones = (await readTombstones()).filter(tombstone => tombstone.id !== id);
+  await tombstoneStore.put(TOMBSTONES_KEY, [{ id, deletedAt }, ...tombstones].slice(0, MAX_TOMBSTONES));
+  pushDelete(id, deletedAt);
+}
+
+function pushDelete(id: string, deletedAt: number) {
+  pushToServer(id, {
+    method: 'DELETE',
+    headers: { 'Content-Type': 'application/json' },
+    body: JSON.stringify({ deletedAt }),
+  });
+}
+
+/**
+ * Pulls designs from the sync endpoint that are missing locally or newer
+ * there, and drops local copies of designs deleted there; returns the
+ * merged list. A no-op without an endpoint.
+ */
+export async function syncDesigns(signal?: AbortSignal): Promise<DesignSummary[]> {
+  if (!DESIGN_SYNC_ENDPOINT) return readSummaries();
+
+  const response = await syncFetch('', { signal, cache: 'no-cache' });
+  if (!response.ok) throw new Error(`Design list failed with status ${response.status}`);
+  const remote = (await response.json()) as DesignList;
+
+  const local = new Map((await readSummaries()).map(summary => [summary.id, summary]));
+  for (const { id, deletedAt } of remote.deleted) {
+    throwIfAborted(signal);
+    const summary = local.get(id);
+    if (summary && summary.savedAt <= deletedAt) {
+      await removeLocalDesign(id);
+      local.delete(id);
+    }
+  }
+
+  const deletedHere = new Map((await readTombstones()).map(tombstone => [tombstone.id, tombstone.deletedAt]));
+  const stale = remote.designs.filter(summary => {
+    const deletedAt = deletedHere.get(summary.id);
+    if (deletedAt !== undefined && deletedAt >= summary.savedAt) {
+      pushDelete(summary.id, deletedAt); // The delete never reached the server
+      return false;
+    }
+    return (local.get(summary.id)?.savedAt ?? -1) < summary.savedAt;
+  });
+
+  for (const summary of stale) {
+    throwIfAborted(signal);
+    const designResponse = await syncFetch(`/${encodeURIComponent(summary.id)}`, { signal });
+    if (!designResponse.ok) continue; // Deleted meanwhile
+    const { delta, messages, ...rest } = (await designResponse.json()) as DesignRecord;
+    await designStore.put(rest.id, { ...rest, delta: fromBase64(delta), messages });
+    await writeSummary(rest);
+  }
+  return readSummaries();
+}
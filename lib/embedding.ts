@@ -0,0 +1,104 @@
+import { Furniture } from '@/types/furniture';
+
+/**
+ * Lightweight text embeddings for in-process retrieval
+ *
+ * Uses the hashing trick over word tokens and character trigrams, so no
+ * model weights need to ship with the app. In a real deployment these would
+ * come from an embedding model; the index code does not care where the
+ * vectors come from as long as they are L2-normalised.
+ */
+
+/**
+ * Total vector width, including the trailing confidence-prior dimension
+ */
+export const EMBEDDING_DIM = 64;
+
+// The last dimension carries the catalogue confidence score as a ranking prior
+const TEXT_DIM = EMBEDDING_DIM - 1;
+const PRIOR_WEIGHT = Math.SQRT1_2;
+const TRIGRAM_WEIGHT = 0.5;
+
+const STOP_WORDS = new Set([
+  'a', 'an', 'and', 'the', 'for', 'with', 'of', 'in', 'to', 'me', 'my',
+  'show', 'generate', 'create', 'style', 'room', 'living', 'setup',
+]);
+
+/**
+ * 32-bit FNV-1a hash
+ */
+export function fnv1a(text: string): number {
+  let hash = 0x811c9dc5;
+  for (let i = 0; i < text.length; i++) {
+    hash ^= text.charCodeAt(i);
+    hash = Math.imul(hash, 0x01000193);
+  }
+  return hash >>> 0;
+}
+
+/**
+ * Splits text into lowercase word tokens with a crude plural strip
+ */
+export function tokenize(text: string): string[] {
+  return text
+    .toLowerCase()
+    .split(/[^a-z0-9]+/)
+    .filter(token => token.length > 0 && !STOP_WORDS.has(token))
+    .map(token => (token.length > 3 && token.endsWith('s') ? token.slice(0, -1) : token));
+}
+
+function addFeature(out: Float32Array, feature: string, weight: number) {
+  const hash = fnv1a(feature);
+  const sign = hash & 0x80000000 ? -1 : 1;
+  out[hash % TEXT_DIM] += sign * weight;
+}
+
+function normalizeText(out: Float32Array) {
+  let norm = 0;
+  for (let i = 0; i < TEXT_DIM; i++) norm += out[i] * out[i];
+  if (norm === 0) return;
+  const scale = 1 / Math.sqrt(norm);
+  for (let i = 0; i < TEXT_DIM; i++) out[i] *= scale;
+}
+
+/**
+ * Accumulates weighted text features into `out` (text dimensions only)
+ */
+function accumulateText(out: Float32Array, text: string, weight: number) {
+  tokenize(text).forEach(token => {
+    addFeature(out, token, weight);
+    const padded = `^${token}$`;
+    for (let i = 0; i + 3 <= padded.length; i++) {
+      addFeature(out, padded.slice(i, i + 3), weight * TRIGRAM_WEIGHT);
+    }
+  });
+}
+
+/**
+ * Embeds a user query
+ * The prior dimension is constant so that item confidence acts as a bias
+ */
+export function embedQuery(query: string, out: Float32Array = new Float32Array(EMBEDDING_DIM)): Float32Array {
+  out.fill(0);
+  accumulateText(out, query, 1);
+  normalizeText(out);
+  out[TEXT_DIM] = PRIOR_WEIGHT;
+  return out;
+}
+
+/**
+ * Embeds a catalogue item from its name, category and description
+ * The prior dimension stores the item's confidence score
+ */
+export function embedFurniture(
+  item: Pick<Furniture, 'name' | 'category' | 'description' | 'confidenceScore'>,
+  out: Float32Array = new Float32Array(EMBEDDING_DIM)
+): Float32Array {
+  out.fill(0);
+  accumulateText(out, item.name, 1);
+  accumulateText(out, item.category, 1);
+  if (item.description) accumulateText(out, item.description, 0.5);
+  normalizeText(out);
+  out[TEXT_DIM] = item.confidenceScore * PRIOR_WEIGHT;
+  return out;
+}
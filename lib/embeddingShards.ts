@@ -0,0 +1,123 @@
+import { RoomStyle } from '@/types/chat';
+import { BinaryCatalogue } from './binaryCatalogue';
+import { EMBEDDING_DIM, embedFurniture } from './embedding';
+import { SearchHit, TopK, VectorIndex } from './vectorIndex';
+
+/**
+ * Precomputed, int8-quantized embedding shards
+ *
+ * scripts/build-embedding-shards.ts writes one shard per catalogue shard
+ * before `next build`, so item vectors are computed once at build time
+ * instead of on every cold start. The server searches them directly and the
+ * static /api/embeddings/[shard] route serves them to the browser. Rows
+ * line up with the catalogue shard's item order. Layout:
+ *
+ *   header  u32 × 5   magic, format version, rows, dimensions, shard version
+ *   scales  f32 × n   per-row dequantization scale
+ *   values  i8 × n·d  round(v / scale), so each row spans -127..127
+ *
+ * Per-row symmetric quantization keeps dot products within about 1% of the
+ * float vectors at a quarter of the size.
+ */
+
+const MAGIC = 0x42454344; // 'DCEB'
+const FORMAT_VERSION = 1;
+const HEADER_WORDS = 5;
+
+export const EMBEDDING_SHARD_ENDPOINT = '/api/embeddings';
+export const EMBEDDING_SHARD_CONTENT_TYPE = 'application/vnd.decoplan.embeddings';
+
+/**
+ * Catalogue shard searched for category retrievals and most styles
+ */
+export const DEFAULT_SHARD = 'default';
+
+/**
+ * Catalogue shard searched for each room style
+ */
+export const STYLE_SHARDS: Record<RoomStyle, string> = {
+  japanese: 'japanese',
+  modern: DEFAULT_SHARD,
+  minimalist: DEFAULT_SHARD,
+  scandinavian: DEFAULT_SHARD,
+  industrial: DEFAULT_SHARD,
+  traditional: DEFAULT_SHARD,
+};
+
+/**
+ * Catalogue shard versions are base36 u32 hashes (lib/catalogueManifest.ts)
+ */
+export function shardVersionWord(version: string): number {
+  return parseInt(version, 36) >>> 0;
+}
+
+/**
+ * Embeds every catalogue row and quantizes the vectors into a shard
+ */
+export function encodeEmbeddingShard(catalogue: BinaryCatalogue, version: string): ArrayBuffer {
+  const { count } = catalogue;
+  const dim = EMBEDDING_DIM;
+  const buffer = new ArrayBuffer(HEADER_WORDS * 4 + count * 4 + count * dim);
+  new Uint32Array(buffer, 0, HEADER_WORDS).set([MAGIC, FORMAT_VERSION, count, dim, shardVersionWord(version)]);
+  const scales = new Float32Array(buffer, HEADER_WORDS * 4, count);
+  const values = new Int8Array(buffer, HEADER_WORDS * 4 + count * 4, count * dim);
+
+  const vector = new Float32Array(dim);
+  for (let row = 0; row < count; row++) {
+    embedFurniture(catalogue.embeddingFields(row), vector);
+    let maxAbs = 0;
+    for (let i = 0; i < dim; i++) maxAbs = Math.max(maxAbs, Math.abs(vector[i]));
+    const scale = maxAbs / 127;
+    scales[row] = scale;
+    if (scale === 0) continue;
+    for (let i = 0; i < dim; i++) values[row * dim + i] = Math.round(vector[i] / scale);
+  }
+  return buffer;
+}
+
+/**
+ * Exhaustive search straight over an int8 shard, without dequantizing it
+ */
+export class QuantizedIndex implements VectorIndex {
+  readonly dim: number;
+  readonly size: number;
+  readonly version: number; // Shard version word the vectors were built from
+  readonly buffer: ArrayBuffer; // The encoded shard
+  private readonly scales: Float32Array;
+  private readonly values: Int8Array;
+
+  constructor(buffer: ArrayBuffer) {
+    const [magic, format, count, dim, version] = new Uint32Array(buffer, 0, HEADER_WORDS);
+    if (magic !== MAGIC) throw new Error('Not an embedding shard');
+    if (format !== FORMAT_VERSION) throw new Error(`Unsupported embedding shard format ${format}`);
+    this.buffer = buffer;
+    this.size = count;
+    this.dim = dim;
+    this.version = version;
+    this.scales = new Float32Array(buffer, HEADER_WORDS * 4, count);
+    this.values = new Int8Array(buffer, HEADER_WORDS * 4 + count * 4, count * dim);
+  }
+
+  add(): number {
+    throw new Error('Embedding shards are read-only; rebuild the shard instead');
+  }
+
+  search(query: Float32Array, k: number): SearchHit[] {
+    const { values, scales, dim, size } = this;
+    const top = new TopK(k);
+    for (let row = 0, offset = 0; row < size; row++, offset += dim) {
+      let sum = 0;
+      for (let i = 0; i < dim; i++) sum += values[offset + i] * query[i];
+      top.offer(row, sum * scales[row]);
+    }
+    return top.drain();
+  }
+
+  score(id: number, query: Float32Array): number {
+    const { values, dim } = this;
+    const offset = id * dim;
+    let sum = 0;
+    for (let i = 0; i < dim; i++) sum += values[offset + i] * query[i];
+    return sum * this.scales[id];
+  }
+}
@@ -0,0 +1,189 @@
+import { Color, FloorPlan, FloorPlanRoom } from '@/types/furniture';
+import type { Portal, RoomCell } from './culling';
+import type { Rect } from './spatialIndex';
+import { ROOM_DEPTH, ROOM_HEIGHT, ROOM_WIDTH } from './roomStats';
+
+/**
+ * Multi-room floor plans
+ *
+ * A plan is a list of rooms, each a RoomConfig placed by the centre of its
+ * floor, plus the doorways between them. Rooms are axis-aligned and meet
+ * at shared walls. The helpers here turn a plan into what the viewer
+ * needs: room cells and portals for culling, and wall segments with gaps
+ * left for the doors.
+ */
+
+export const WALL_COLOR: Color = { r: 245, g: 245, b: 245 };
+export const FLOOR_COLOR: Color = { r: 212, g: 196, b: 176 };
+
+// Positions closer than this are on the same wall
+const EPSILON = 1e-3;
+
+const DEFAULT_CONFIG = {
+  height: ROOM_HEIGHT,
+  wallColor: WALL_COLOR,
+  floorColor: FLOOR_COLOR,
+};
+
+/**
+ * The demo living room on its own
+ */
+export const SINGLE_ROOM_PLAN: FloorPlan = {
+  rooms: [
+    {
+      id: 'living',
+      name: 'Living room',
+      origin: { x: 0, z: 0 },
+      config: { width: ROOM_WIDTH, length: ROOM_DEPTH, ...DEFAULT_CONFIG },
+      query: 'Modern HDB living room setup',
+    },
+  ],
+  doorways: [],
+};
+
+/**
+ * A 4-room HDB flat: the living room, with the kitchen and master bedroom
+ * behind it and a second bedroom to the side
+ */
+export const HDB_FLOOR_PLAN: FloorPlan = {
+  rooms: [
+    SINGLE_ROOM_PLAN.rooms[0],
+    {
+      id: 'kitchen',
+      name: 'Kitchen',
+      origin: { x: -3, z: -6 },
+      config: { width: 4, length: 4, ...DEFAULT_CONFIG },
+      query: 'Compact HDB kitchen with cabinets, shelves and a small table',
+    },
+    {
+      id: 'master',
+      name: 'Master bedroom',
+      origin: { x: 2, z: -6.5 },
+      config: { width: 6, length: 5, ...DEFAULT_CONFIG },
+      query: 'Cosy master bedroom with a bed, cabinet and lamp',
+    },
+    {
+      id: 'bedroom',
+      name: 'Bedroom',
+      origin: { x: 7, z: -2 },
+      config: { width: 4, length: 4, ...DEFAULT_CONFIG },
+      query: 'Minimalist bedroom with a bed and shelf',
+    },
+  ],
+  doorways: [
+    { rooms: ['living', 'kitchen'], x: -3, z: -4, width: 0.9 },
+    { rooms: ['living', 'master'], x: 3, z: -4, width: 0.9 },
+    { rooms: ['living', 'bedroom'], x: 5, z: -2, width: 0.9 },
+  ],
+};
+
+/**
+ * Floor rectangle of a room in plan coordinates
+ */
+export function roomBounds(room: FloorPlanRoom): Rect {
+  const halfWidth = room.config.width / 2;
+  const halfLength = room.config.length / 2;
+  return {
+    minX: room.origin.x - halfWidth,
+    minZ: room.origin.z - halfLength,
+    maxX: room.origin.x + halfWidth,
+    maxZ: room.origin.z + halfLength,
+  };
+}
+
+/**
+ * Floor rectangle enclosing every room of a plan
+ */
+export function planBounds(plan: FloorPlan): Rect {
+  return plan.rooms.map(roomBounds).reduce((bounds, room) => ({
+    minX: Math.min(bounds.minX, room.minX),
+    minZ: Math.min(bounds.minZ, room.minZ),
+    maxX: Math.max(bounds.maxX, room.maxX),
+    maxZ: Math.max(bounds.maxZ, room.maxZ),
+  }));
+}
+
+/**
+ * Horizontal distance from a point to a room; 0 inside it
+ */
+export function distanceToRoom(room: FloorPlanRoom, x: number, z: number): number {
+  const bounds = roomBounds(room);
+  const dx = Math.max(bounds.minX - x, 0, x - bounds.maxX);
+  const dz = Math.max(bounds.minZ - z, 0, z - bounds.maxZ);
+  return Math.hypot(dx, dz);
+}
+
+export function roomCells(plan: FloorPlan): RoomCell[] {
+  return plan.rooms.map(room => ({ id: room.id, bounds: roomBounds(room), height: room.config.height }));
+}
+
+/**
+ * Doorways as culling portals. The opening is a square the width of the
+ * door, so it reaches a little into both rooms
+ */
+export function planPortals(plan: FloorPlan): Portal[] {
+  const heights = new Map(plan.rooms.map(room => [room.id, room.config.height]));
+  return plan.doorways.map(door => {
+    const half = door.width / 2;
+    return {
+      rooms: door.rooms,
+      opening: { minX: door.x - half, minZ: door.z - half, maxX: door.x + half, maxZ: door.z + half },
+      height: Math.min(heights.get(door.rooms[0]) ?? ROOM_HEIGHT, heights.get(door.rooms[1]) ?? ROOM_HEIGHT),
+    };
+  });
+}
+
+/**
+ * A straight run of wall, facing into its room
+ */
+export interface WallSegment {
+  key: string;
+  x: number; // Centre on the floor
+  z: number;
+  length: number;
+  rotationY: number; // Turns a +Z-facing plane to face into the room
+}
+
+/**
+ * The four walls of a room, split around its doorways
+ */
+export function wallSegments(plan: FloorPlan, room: FloorPlanRoom): WallSegment[] {
+  const { minX, minZ, maxX, maxZ } = roomBounds(room);
+  const doors = plan.doorways.filter(door => door.rooms.includes(room.id));
+
+  const sides = [
+    { name: 'back', fixed: minZ, from: minX, to: maxX, alongX: true, rotationY: 0 },
+    { name: 'front', fixed: maxZ, from: minX, to: maxX, alongX: true, rotationY: Math.PI },
+    { name: 'left', fixed: minX, from: minZ, to: maxZ, alongX: false, rotationY: Math.PI / 2 },
+    { name: 'right', fixed: maxX, from: minZ, to: maxZ, alongX: false, rotationY: -Math.PI / 2 },
+  ];
+
+  return sides.flatMap(side => {
+    // Door gaps on this side, in order along it
+    const gaps = doors
+      .filter(door => Math.abs((side.alongX ? door.z : door.x) - side.fixed) < EPSILON)
+      .map(door => {
+        const centre = side.alongX ? door.x : door.z;
+        return [centre - door.width / 2, centre + door.width / 2];
+      })
+      .sort((a, b) => a[0] - b[0]);
+
+    const segments: WallSegment[] = [];
+    let start = side.from;
+    [...gaps, [side.to, side.to]].forEach(([gapStart, gapEnd], i) => {
+      const end = Math.min(gapStart, side.to);
+      if (end - start > EPSILON) {
+        const centre = (start + end) / 2;
+        segments.push({
+          key: `${side.name}-${i}`,
+          x: side.alongX ? centre : side.fixed,
+          z: side.alongX ? side.fixed : centre,
+          length: end - start,
+          rotationY: side.rotationY,
+        });
+      }
+      start = Math.max(start, gapEnd);
+    });
+    return segments;
+  });
+}
@@ -0,0 +1,28 @@
+import { FurnitureCategory } from '@/types/furniture';
+
+/**
+ * Dense numeric codes for furniture categories
+ * Shared by packed formats (layout requests, the binary catalogue) so a
+ * code means the same category everywhere. Append only: codes are stored.
+ */
+export const FURNITURE_CATEGORIES: readonly FurnitureCategory[] = [
+  'sofa',
+  'table',
+  'chair',
+  'bed',
+  'cabinet',
+  'shelf',
+  'lamp',
+  'other',
+];
+
+const OTHER_CODE = FURNITURE_CATEGORIES.indexOf('other');
+
+export function categoryCode(category: FurnitureCategory): number {
+  const code = FURNITURE_CATEGORIES.indexOf(category);
+  return code === -1 ? OTHER_CODE : code;
+}
+
+export function categoryFromCode(code: number): FurnitureCategory {
+  return FURNITURE_CATEGORIES[code] ?? 'other';
+}
@@ -1,4 +1,7 @@
-import { Furniture, FurnitureCategory } from '@/types/furniture';
+import { Furniture } from '@/types/furniture';
+
+// Re-exported for existing imports; client code imports lib/furnitureColors
+export { CATEGORY_COLORS, rgbToHex } from './furnitureColors';
 
 /**
  * Mock furniture database simulating items that would be retrieved by RAG system
@@ -213,28 +216,3 @@ export const JAPANESE_FURNITURE_DATABASE: Omit<Furniture, 'visible'>[] = [
     description: 'Decorative stand for bonsai or ikebana',
   },
 ];
-
-/**
- * Category color mapping for 3D visualization
- * Returns consistent colors for each furniture category
- */
-export const CATEGORY_COLORS: Record<FurnitureCategory, string> = {
-  sofa: '#6B7280', // Gray
-  table: '#8B5A3C', // Brown
-  chair: '#505050', // Dark Gray
-  bed: '#9CA3AF', // Light Gray
-  cabinet: '#46362C', // Dark Brown
-  shelf: '#C8C8C8', // Light Gray
-  lamp: '#DCC864', // Yellow/Gold
-  other: '#94A3B8', // Slate Gray
-};
-
-/**
- * Helper function to get hex color from RGB
- */
-export function rgbToHex(r: number, g: number, b: number): string {
-  return '#' + [r, g, b].map(x => {
-    const hex = x.toString(16);
-    return hex.length === 1 ? '0' + hex : hex;
-  }).join('');
-}
@@ -0,0 +1,122 @@
+import { Furniture } from '@/types/furniture';
+
+/**
+ * Keyed reconciliation between furniture lists
+ *
+ * Retrieval results arrive as brand-new arrays of brand-new objects. Diffing
+ * them by id against what is on screen lets unchanged items keep their object
+ * identity, so memoized list rows, meshes and instance slots can tell they
+ * have nothing to do.
+ */
+
+export interface FurnitureDiff {
+  added: Furniture[];
+  removed: Furniture[];
+  changed: Furniture[]; // New versions of items whose fields differ
+  unchanged: number;
+  next: Furniture[]; // Reconciled list, reusing previous objects where equal
+}
+
+export interface ReconcileOptions {
+  // Keep previous items that are missing from `incoming`, appended at the end.
+  // Used while results are still streaming in, so items are not removed and
+  // re-added before the full result set is known.
+  keepMissing?: boolean;
+}
+
+function sameLods(a: Furniture['modelLods'], b: Furniture['modelLods']): boolean {
+  if (a === b) return true;
+  if (!a || !b || a.length !== b.length) return false;
+  return a.every((lod, i) => lod.url === b[i].url && lod.distance === b[i].distance);
+}
+
+/**
+ * Field-wise equality for furniture items
+ */
+export function isSameFurniture(a: Furniture, b: Furniture): boolean {
+  return (
+    a.id === b.id &&
+    a.name === b.name &&
+    a.category === b.category &&
+    a.visible === b.visible &&
+    a.confidenceScore === b.confidenceScore &&
+    a.description === b.description &&
+    a.modelUrl === b.modelUrl &&
+    sameLods(a.modelLods, b.modelLods) &&
+    a.position.x === b.position.x &&
+    a.position.y === b.position.y &&
+    a.position.z === b.position.z &&
+    (a.rotationY ?? 0) === (b.rotationY ?? 0) &&
+    a.dimensions.width === b.dimensions.width &&
+    a.dimensions.height === b.dimensions.height &&
+    a.dimensions.depth === b.dimensions.depth &&
+    a.color.r === b.color.r &&
+    a.color.g === b.color.g &&
+    a.color.b === b.color.b
+  );
+}
+
+/**
+ * Diffs `incoming` against `previous` by id
+ * `next` follows the order of `incoming`
+ */
+export function reconcileFurniture(
+  previous: Furniture[],
+  incoming: Furniture[],
+  options: ReconcileOptions = {}
+): FurnitureDiff {
+  const previousById = new Map<string, Furniture>();
+  previous.forEach(item => previousById.set(item.id, item));
+
+  const added: Furniture[] = [];
+  const changed: Furniture[] = [];
+  const next: Furniture[] = [];
+  const seen = new Set<string>();
+  let unchanged = 0;
+
+  incoming.forEach(item => {
+    seen.add(item.id);
+    const existing = previousById.get(item.id);
+    if (!existing) {
+      added.push(item);
+      next.push(item);
+    } else if (existing === item || isSameFurniture(existing, item)) {
+      unchanged++;
+      next.push(existing);
+    } else {
+      changed.push(item);
+      next.push(item);
+    }
+  });
+
+  const removed: Furniture[] = [];
+  previous.forEach(item => {
+    if (seen.has(item.id)) return;
+    if (options.keepMissing) {
+      next.push(item);
+    } else {
+      removed.push(item);
+    }
+  });
+
+  return { added, removed, changed, unchanged, next };
+}
+
+/**
+ * Returns `previous` itself when reconciliation changes nothing, so that
+ * React state setters can bail out of re-rendering
+ */
+export function reconcileList(
+  previous: Furniture[],
+  incoming: Furniture[],
+  options?: ReconcileOptions
+): Furniture[] {
+  const diff = reconcileFurniture(previous, incoming, options);
+  const identical =
+    diff.added.length === 0 &&
+    diff.removed.length === 0 &&
+    diff.changed.length === 0 &&
+    diff.next.length === previous.length &&
+    diff.next.every((item, index) => item === previous[index]);
+  return identical ? previous : diff.next;
+}
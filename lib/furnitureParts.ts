@@ -0,0 +1,126 @@
+import * as THREE from 'three';
+import { Dimensions, Furniture, FurnitureCategory } from '@/types/furniture';
+
+/**
+ * Primitive shapes used to draw placeholder furniture and room shells
+ * Every shape is a unit-sized geometry that is scaled per item
+ */
+export type PartShape = 'box' | 'cylinder' | 'sphere' | 'plane';
+
+/**
+ * Material variants shared by furniture parts
+ */
+export type PartMaterial = 'standard' | 'translucent' | 'emissive';
+
+/**
+ * A single sub-part of a placeholder furniture mesh (chair seat, lamp shade, ...)
+ * Scale and offset are derived from the item's dimensions
+ */
+export interface FurniturePart {
+  key: string;
+  shape: PartShape;
+  material: PartMaterial;
+  scale: (dimensions: Dimensions) => [number, number, number];
+  offset: (dimensions: Dimensions) => [number, number, number];
+}
+
+const ORIGIN = (): [number, number, number] => [0, 0, 0];
+
+const BODY_PART: FurniturePart = {
+  key: 'body',
+  shape: 'box',
+  material: 'standard',
+  scale: d => [d.width, d.height, d.depth],
+  offset: ORIGIN,
+};
+
+/**
+ * Sub-part layout for each furniture category
+ * Mirrors the placeholder shapes drawn by FurnitureMesh
+ */
+const CATEGORY_PARTS: Partial<Record<FurnitureCategory, FurniturePart[]>> = {
+  lamp: [
+    {
+      key: 'stand',
+      shape: 'cylinder',
+      material: 'standard',
+      scale: d => [0.1, d.height * 0.8, 0.1],
+      offset: ORIGIN,
+    },
+    {
+      key: 'shade',
+      shape: 'sphere',
+      material: 'emissive',
+      scale: () => [0.3, 0.3, 0.3],
+      offset: d => [0, d.height * 0.4, 0],
+    },
+  ],
+  chair: [
+    {
+      key: 'seat',
+      shape: 'box',
+      material: 'standard',
+      scale: d => [d.width, d.height * 0.4, d.depth],
+      offset: ORIGIN,
+    },
+    {
+      key: 'back',
+      shape: 'box',
+      material: 'standard',
+      scale: d => [d.width, d.height * 0.6, d.depth * 0.1],
+      offset: d => [0, d.height * 0.3, -d.depth * 0.35],
+    },
+  ],
+  shelf: [{ ...BODY_PART, material: 'translucent' }],
+};
+
+/**
+ * Gets the sub-parts used to draw a furniture category
+ */
+export function getFurnitureParts(category: FurnitureCategory): FurniturePart[] {
+  return CATEGORY_PARTS[category] ?? [BODY_PART];
+}
+
+/**
+ * Creates the unit geometry for a part shape
+ * Box is 1×1×1, cylinder and sphere have a diameter and height of 1, and
+ * the plane is 1×1 in XY facing +z
+ */
+export function createPartGeometry(shape: PartShape): THREE.BufferGeometry {
+  switch (shape) {
+    case 'cylinder':
+      return new THREE.CylinderGeometry(0.5, 0.5, 1, 8);
+    case 'sphere':
+      return new THREE.SphereGeometry(0.5, 16, 16);
+    case 'plane':
+      return new THREE.PlaneGeometry(1, 1);
+    case 'box':
+    default:
+      return new THREE.BoxGeometry(1, 1, 1);
+  }
+}
+
+const scratchPosition = new THREE.Vector3();
+const scratchScale = new THREE.Vector3();
+const scratchRotation = new THREE.Quaternion();
+const UP = new THREE.Vector3(0, 1, 0);
+
+/**
+ * Writes the world matrix of a furniture part into `target`
+ * The part's offset turns with the item
+ */
+export function composePartMatrix(
+  { position, rotationY = 0, dimensions }: Pick<Furniture, 'position' | 'rotationY' | 'dimensions'>,
+  part: FurniturePart,
+  target: THREE.Matrix4
+): THREE.Matrix4 {
+  const [ox, oy, oz] = part.offset(dimensions);
+  const [sx, sy, sz] = part.scale(dimensions);
+  scratchRotation.setFromAxisAngle(UP, rotationY);
+  scratchPosition.set(ox, oy, oz).applyQuaternion(scratchRotation);
+  scratchPosition.x += position.x;
+  scratchPosition.y += position.y;
+  scratchPosition.z += position.z;
+  scratchScale.set(sx, sy, sz);
+  return target.compose(scratchPosition, scratchRotation, scratchScale);
+}
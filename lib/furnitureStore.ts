@@ -0,0 +1,234 @@
+import { useSyncExternalStore } from 'react';
+import { Furniture } from '@/types/furniture';
+import { ReconcileOptions, reconcileList } from './furnitureDiff';
+import { ROOM_DEPTH, ROOM_WIDTH, RoomCoverage, footprintOf, summarizeCoverage } from './roomStats';
+import { SpatialGrid, footprintRect, unionArea } from './spatialIndex';
+
+/**
+ * Derived statistics, kept as running totals by the store
+ */
+export interface FurnitureStats extends RoomCoverage {
+  visibleCount: number;
+  totalCount: number;
+  overlapCount: number; // Pairs of visible items whose footprints overlap
+}
+
+/**
+ * Normalized furniture state
+ *
+ * Items are indexed by id, and visibility is mirrored in a bitset, so
+ * lookups and visible counts are O(1). A toggle's bookkeeping is O(1) too,
+ * but publishing it costs one O(n) copy of the list: the snapshot is a
+ * plain Furniture[] that React compares by reference, in which only
+ * changed items get new objects. Batch operations (setVisibility,
+ * setAllVisible) touch each affected item once, copy the list once and
+ * notify subscribers once, however many items change.
+ *
+ * Visible count and footprint are running totals adjusted on every toggle,
+ * so statistics never rescan the list. Visible footprints also live in a
+ * spatial grid that counts overlapping pairs as items are shown and hidden.
+ * While nothing overlaps, the running sum is the exact covered area; once
+ * something does, the union area is recomputed, lazily, the next time stats
+ * are read. `getStats` returns the same object until a value changes.
+ */
+export class FurnitureStore {
+  private items: Furniture[] = [];
+  private indexById = new Map<string, number>();
+  private visibility = new Uint32Array(0);
+  private visibleTotal = 0;
+  private footprint = 0; // Sum of visible items' floor area
+  private visibleGrid = new SpatialGrid();
+  private overlapPairs = 0;
+  private stats: FurnitureStats;
+  private statsDirty = false;
+  private listeners = new Set<() => void>();
+
+  constructor(
+    private readonly roomWidth = ROOM_WIDTH,
+    private readonly roomDepth = ROOM_DEPTH
+  ) {
+    this.stats = this.computeStats();
+  }
+
+  /**
+   * Subscribes to changes; compatible with useSyncExternalStore
+   */
+  subscribe = (listener: () => void): (() => void) => {
+    this.listeners.add(listener);
+    return () => {
+      this.listeners.delete(listener);
+    };
+  };
+
+  /**
+   * Current furniture list; the same array until the next change
+   */
+  getSnapshot = (): Furniture[] => this.items;
+
+  /**
+   * Current statistics; the same object until a total changes
+   */
+  getStats = (): FurnitureStats => {
+    if (this.statsDirty) {
+      this.statsDirty = false;
+      const stats = this.computeStats();
+      if (
+        stats.totalFootprint !== this.stats.totalFootprint ||
+        stats.coveragePercentage !== this.stats.coveragePercentage ||
+        stats.visibleCount !== this.stats.visibleCount ||
+        stats.totalCount !== this.stats.totalCount ||
+        stats.overlapCount !== this.stats.overlapCount
+      ) {
+        this.stats = stats;
+      }
+    }
+    return this.stats;
+  };
+
+  get size(): number {
+    return this.items.length;
+  }
+
+  get visibleCount(): number {
+    return this.visibleTotal;
+  }
+
+  get(id: string): Furniture | undefined {
+    const index = this.indexById.get(id);
+    return index === undefined ? undefined : this.items[index];
+  }
+
+  isVisible(id: string): boolean {
+    const index = this.indexById.get(id);
+    return index !== undefined && this.bit(index);
+  }
+
+  /**
+   * Replaces the list with a retrieval result, reconciled by id
+   */
+  replace(incoming: Furniture[], options?: ReconcileOptions) {
+    const next = reconcileList(this.items, incoming, options);
+    if (next === this.items) return;
+
+    this.items = next;
+    this.indexById = new Map();
+    this.visibility = new Uint32Array(Math.ceil(next.length / 32));
+    this.visibleTotal = 0;
+    this.footprint = 0;
+    this.visibleGrid.clear();
+    this.overlapPairs = 0;
+    next.forEach((item, index) => {
+      this.indexById.set(item.id, index);
+      if (item.visible) {
+        this.visibility[index >>> 5] |= 1 << (index & 31);
+        this.visibleTotal++;
+        this.footprint += footprintOf(item);
+        this.showFootprint(item);
+      }
+    });
+    this.emit();
+  }
+
+  toggle(id: string) {
+    const index = this.indexById.get(id);
+    if (index === undefined) return;
+    this.applyVisibility([index], !this.bit(index));
+  }
+
+  /**
+   * Shows or hides several items with a single update
+   */
+  setVisibility(ids: string[], visible: boolean) {
+    const indexes: number[] = [];
+    ids.forEach(id => {
+      const index = this.indexById.get(id);
+      if (index !== undefined) indexes.push(index);
+    });
+    this.applyVisibility(indexes, visible);
+  }
+
+  /**
+   * Shows or hides every item with a single update
+   */
+  setAllVisible(visible: boolean) {
+    if (this.visibleTotal === (visible ? this.items.length : 0)) return;
+    this.applyVisibility(this.items.map((_, index) => index), visible);
+  }
+
+  private bit(index: number): boolean {
+    return (this.visibility[index >>> 5] & (1 << (index & 31))) !== 0;
+  }
+
+  private applyVisibility(indexes: number[], visible: boolean) {
+    let next: Furniture[] | null = null;
+
+    for (const index of indexes) {
+      if (this.bit(index) === visible) continue;
+      if (visible) {
+        this.visibility[index >>> 5] |= 1 << (index & 31);
+        this.visibleTotal++;
+        this.footprint += footprintOf(this.items[index]);
+        this.showFootprint(this.items[index]);
+      } else {
+        this.visibility[index >>> 5] &= ~(1 << (index & 31));
+        this.visibleTotal--;
+        this.footprint -= footprintOf(this.items[index]);
+        this.hideFootprint(this.items[index]);
+      }
+      // Copy the list once per batch, then swap in the changed items
+      next = next ?? this.items.slice();
+      next[index] = { ...this.items[index], visible };
+    }
+
+    if (next) {
+      // Drop floating-point drift once nothing is left to add up
+      if (this.visibleTotal === 0) this.footprint = 0;
+      this.items = next;
+      this.emit();
+    }
+  }
+
+  private showFootprint(item: Furniture) {
+    const rect = footprintRect(item);
+    this.overlapPairs += this.visibleGrid.query(rect, item.id).length;
+    this.visibleGrid.insert(item.id, rect);
+  }
+
+  private hideFootprint(item: Furniture) {
+    const rect = this.visibleGrid.get(item.id);
+    if (!rect) return;
+    this.visibleGrid.remove(item.id);
+    this.overlapPairs -= this.visibleGrid.query(rect).length;
+  }
+
+  private computeStats(): FurnitureStats {
+    const covered =
+      this.overlapPairs === 0 ? this.footprint : unionArea(this.visibleGrid.rectangles());
+    return {
+      ...summarizeCoverage(covered, this.visibleTotal, this.roomWidth, this.roomDepth),
+      visibleCount: this.visibleTotal,
+      totalCount: this.items.length,
+      overlapCount: this.overlapPairs,
+    };
+  }
+
+  private emit() {
+    this.statsDirty = true;
+    this.listeners.forEach(listener => listener());
+  }
+}
+
+/**
+ * Subscribes a component to a FurnitureStore's list
+ */
+export function useFurnitureStore(store: FurnitureStore): Furniture[] {
+  return useSyncExternalStore(store.subscribe, store.getSnapshot, store.getSnapshot);
+}
+
+/**
+ * Subscribes a component to a FurnitureStore's statistics only
+ * Re-renders when a total changes, not on every list update
+ */
+export function useFurnitureStats(store: FurnitureStore): FurnitureStats {
+  return useSyncExternalStore(store.subscribe, store.getStats, store.getStats);
+}
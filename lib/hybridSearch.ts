@@ -0,0 +1,144 @@
+import { Furniture, RetrievalTimings } from '@/types/furniture';
+import { BinaryCatalogue } from './binaryCatalogue';
+import { EMBEDDING_DIM, embedFurniture, embedQuery, tokenize } from './embedding';
+import { FURNITURE_CATEGORIES } from './furnitureCategories';
+import { LexicalIndex } from './lexicalIndex';
+import { RERANK_LIMIT, fuseCandidates, rerankCandidates } from './reranker';
+import { SearchHit, VectorIndex, createVectorIndex } from './vectorIndex';
+import { now, searchWithinDeadline } from './retrievalBackend';
+
+/**
+ * Two-stage search over one catalogue shard
+ *
+ * Shared by the server backend (lib/mockRAG.ts) and the in-browser one
+ * (lib/shardRetrieval.ts); neither the catalogue data nor the vectors are
+ * imported here, so it bundles for both.
+ */
+
+/**
+ * Columnar catalogue paired with a vector index over its embeddings and a
+ * BM25 index over its text
+ * Index ids are catalogue rows
+ */
+export interface CatalogueIndex {
+  catalogue: BinaryCatalogue;
+  index: VectorIndex;
+  lexical: LexicalIndex;
+}
+
+/**
+ * Builds the indexes for a catalogue
+ * Rows are embedded here unless a prebuilt vector index is passed in
+ */
+export function buildCatalogueIndex(catalogue: BinaryCatalogue, index?: VectorIndex): CatalogueIndex {
+  if (!index) {
+    index = createVectorIndex(EMBEDDING_DIM, catalogue.count);
+    const scratch = new Float32Array(EMBEDDING_DIM);
+    for (let row = 0; row < catalogue.count; row++) {
+      index.add(embedFurniture(catalogue.embeddingFields(row), scratch));
+    }
+  } else if (index.size !== catalogue.count) {
+    throw new Error(`Vector index has ${index.size} rows, catalogue has ${catalogue.count}`);
+  }
+  return { catalogue, index, lexical: new LexicalIndex(catalogue) };
+}
+
+// Share of the latency budget held back for re-ranking
+const RERANK_BUDGET_SHARE = 0.2;
+
+/**
+ * Top `maxResults` rows for a query; `complete` is false when the deadline
+ * cut either stage short. `timings` has the search and rank stages in ms.
+ * `onHit` receives each hit in rank order as soon as its rank is final.
+ */
+export async function searchCatalogueIndex(
+  { catalogue, index, lexical }: CatalogueIndex,
+  query: string,
+  maxResults: number,
+  deadline: number,
+  signal?: AbortSignal,
+  onHit?: (hit: SearchHit, rank: number) => void
+): Promise<{ hits: SearchHit[]; complete: boolean; timings: RetrievalTimings }> {
+  const searchStart = now();
+  // Stage 1: candidates from the vector index (text similarity blended
+  // with confidence, see lib/embedding.ts) and the BM25 index
+  const embedding = embedQuery(query);
+  const terms = tokenize(query);
+  const poolSize = Math.max(maxResults, RERANK_LIMIT);
+  const searchDeadline = deadline - (deadline - now()) * RERANK_BUDGET_SHARE;
+  const vectorSearch = await searchWithinDeadline(index, embedding, poolSize, searchDeadline, signal);
+  const lexicalHits = lexical.search(terms, poolSize);
+
+  // Stage 2: re-rank a bounded number of fused candidates
+  const rankStart = now();
+  const candidates = fuseCandidates(vectorSearch.hits, lexicalHits, poolSize);
+  const { hits, complete } = rerankCandidates(
+    catalogue,
+    index,
+    candidates,
+    { terms, embedding },
+    maxResults,
+    deadline,
+    onHit
+  );
+  return {
+    hits,
+    complete: vectorSearch.complete && complete,
+    timings: { search: rankStart - searchStart, rank: now() - rankStart },
+  };
+}
+
+/**
+ * Rows in any of `categories`, highest confidence first
+ * Category postings are pre-sorted, so this only merges them
+ */
+export function categoryRows({ catalogue, lexical }: CatalogueIndex, categories: string[]): number[] {
+  const wanted = new Set(categories);
+  const rows: number[] = [];
+  FURNITURE_CATEGORIES.forEach(category => {
+    if (!wanted.has(category)) return;
+    lexical.categoryRows(category).forEach(row => rows.push(row));
+  });
+  if (wanted.size > 1) rows.sort((a, b) => catalogue.confidence[b] - catalogue.confidence[a]);
+  return rows;
+}
+
+/**
+ * Materializes result rows as visible furniture
+ * `onItem` is called with each item as it is built
+ */
+export function rowsToFurniture(
+  catalogue: BinaryCatalogue,
+  rows: number[],
+  onItem?: (furniture: Furniture, rank: number) => void
+): Furniture[] {
+  const furniture: Furniture[] = [];
+  rows.forEach(row => materializeRow(catalogue, row, furniture, onItem));
+  return furniture;
+}
+
+/**
+ * Streams search hits into `furniture` as their ranks become final
+ * Pass the returned callback to searchCatalogueIndex as its `onHit`
+ */
+export function collectHits(
+  catalogue: BinaryCatalogue,
+  furniture: Furniture[],
+  onItem?: (furniture: Furniture, rank: number) => void
+): (hit: SearchHit) => void {
+  return hit => materializeRow(catalogue, hit.id, furniture, onItem);
+}
+
+function materializeRow(
+  catalogue: BinaryCatalogue,
+  row: number,
+  furniture: Furniture[],
+  onItem?: (furniture: Furniture, rank: number) => void
+) {
+  const item: Furniture = {
+    ...catalogue.item(row),
+    visible: true, // All items visible by default
+  };
+  furniture.push(item);
+  onItem?.(item, furniture.length - 1);
+}
@@ -0,0 +1,130 @@
+/**
+ * Minimal promise-based key-value stores on IndexedDB
+ *
+ * One database holds every persistent client cache, one object store per
+ * kind of data, with out-of-line string keys. Where IndexedDB is not
+ * available (SSR, some private browsing modes) the stores fall back to
+ * memory, so callers never need a separate code path.
+ */
+
+const DB_NAME = 'decoplan-cache';
+const DB_VERSION = 3;
+
+// Bump DB_VERSION when adding a store here
+export const CACHE_STORES = ['catalogue', 'meta', 'embeddings', 'designs'] as const;
+export type CacheStoreName = (typeof CACHE_STORES)[number];
+
+let databasePromise: Promise<IDBDatabase | null> | null = null;
+
+function openDatabase(): Promise<IDBDatabase | null> {
+  if (databasePromise) return databasePromise;
+
+  databasePromise = new Promise(resolve => {
+    if (typeof indexedDB === 'undefined') {
+      resolve(null);
+      return;
+    }
+    let request: IDBOpenDBRequest;
+    try {
+      request = indexedDB.open(DB_NAME, DB_VERSION);
+    } catch {
+      resolve(null);
+      return;
+    }
+    request.onupgradeneeded = () => {
+      const db = request.result;
+      CACHE_STORES.forEach(name => {
+        if (!db.objectStoreNames.contains(name)) db.createObjectStore(name);
+      });
+    };
+    request.onsuccess = () => {
+      const db = request.result;
+      // Another tab upgraded the schema; reopen on next use
+      db.onversionchange = () => {
+        db.close();
+        databasePromise = null;
+      };
+      resolve(db);
+    };
+    request.onerror = () => resolve(null);
+    request.onblocked = () => resolve(null);
+  });
+  return databasePromise;
+}
+
+function settle<T>(request: IDBRequest<T>): Promise<T> {
+  return new Promise((resolve, reject) => {
+    request.onsuccess = () => resolve(request.result);
+    request.onerror = () => reject(request.error);
+  });
+}
+
+export class IdbStore<T> {
+  private memory = new Map<string, T>();
+
+  constructor(private readonly name: CacheStoreName) {}
+
+  async get(key: string): Promise<T | undefined> {
+    const db = await openDatabase();
+    if (!db) return this.memory.get(key);
+    return settle<T | undefined>(db.transaction(this.name).objectStore(this.name).get(key));
+  }
+
+  async getMany(keys: string[]): Promise<(T | undefined)[]> {
+    const db = await openDatabase();
+    if (!db) return keys.map(key => this.memory.get(key));
+    // One transaction for the whole batch
+    const store = db.transaction(this.name).objectStore(this.name);
+    return Promise.all(keys.map(key => settle<T | undefined>(store.get(key))));
+  }
+
+  async put(key: string, value: T): Promise<void> {
+    await this.putMany([[key, value]]);
+  }
+
+  /**
+   * Writes several entries in one transaction
+   */
+  async putMany(entries: [string, T][]): Promise<void> {
+    const db = await openDatabase();
+    if (!db) {
+      entries.forEach(([key, value]) => this.memory.set(key, value));
+      return;
+    }
+    const transaction = db.transaction(this.name, 'readwrite');
+    const store = transaction.objectStore(this.name);
+    entries.forEach(([key, value]) => store.put(value, key));
+    await completion(transaction);
+  }
+
+  async deleteMany(keys: string[]): Promise<void> {
+    const db = await openDatabase();
+    if (!db) {
+      keys.forEach(key => this.memory.delete(key));
+      return;
+    }
+    const transaction = db.transaction(this.name, 'readwrite');
+    const store = transaction.objectStore(this.name);
+    keys.forEach(key => store.delete(key));
+    await completion(transaction);
+  }
+
+  async clear(): Promise<void> {
+    const db = await openDatabase();
+    if (!db) {
+      this.memory.clear();
+      return;
+    }
+    const transaction = db.transaction(this.name, 'readwrite');
+    transaction.objectStore(this.name).clear();
+    await completion(transaction);
+  }
+}
+
+function completion(transaction: IDBTransaction): Promise<void> {
+  return new Promise((resolve, reject) => {
+    transaction.oncomplete = () => resolve();
+    transaction.onerror = () => reject(transaction.error);
+    transaction.onabort = () => reject(transaction.error);
+  });
+}
@@ -0,0 +1,34 @@
+import { LayoutOptions, LayoutRequest, solveLayout } from './layoutSolver';
+
+/**
+ * Dedicated worker that runs the layout solver off the main thread
+ * Results go back as transfers, so no position data is copied
+ */
+
+export interface LayoutWorkerRequest {
+  id: number;
+  request: LayoutRequest;
+  options?: LayoutOptions;
+}
+
+export interface LayoutWorkerResponse {
+  id: number;
+  positions?: Float32Array;
+  error?: string;
+}
+
+// Typed locally: the project compiles against the DOM lib, not the worker lib
+const scope = self as unknown as {
+  onmessage: ((event: MessageEvent<LayoutWorkerRequest>) => void) | null;
+  postMessage(message: LayoutWorkerResponse, transfer?: Transferable[]): void;
+};
+
+scope.onmessage = event => {
+  const { id, request, options } = event.data;
+  try {
+    const positions = solveLayout(request, options);
+    scope.postMessage({ id, positions }, [positions.buffer]);
+  } catch (error) {
+    scope.postMessage({ id, error: error instanceof Error ? error.message : String(error) });
+  }
+};
@@ -0,0 +1,154 @@
+import { Furniture } from '@/types/furniture';
+import { LAYOUT_STRIDE, LayoutOptions, LayoutRequest, solveLayout } from './layoutSolver';
+import { categoryCode } from './furnitureCategories';
+import type { LayoutWorkerRequest, LayoutWorkerResponse } from './layout.worker';
+import { createAbortError, throwIfAborted } from './retrievalBackend';
+
+/**
+ * Main-thread side of the layout worker
+ *
+ * Packs furniture into typed arrays, transfers them to the worker and
+ * applies the returned positions. Falls back to solving on the main thread
+ * where workers are unavailable (SSR, very old browsers) or fail to start.
+ */
+
+interface PendingLayout {
+  resolve: (positions: Float32Array) => void;
+  reject: (error: Error) => void;
+}
+
+let worker: Worker | null = null;
+let workerFailed = false;
+let nextId = 0;
+const pending = new Map<number, PendingLayout>();
+
+function getWorker(): Worker | null {
+  if (worker || workerFailed || typeof Worker === 'undefined') return worker;
+  try {
+    worker = new Worker(new URL('./layout.worker.ts', import.meta.url));
+    worker.onmessage = (event: MessageEvent<LayoutWorkerResponse>) => {
+      const { id, positions, error } = event.data;
+      const request = pending.get(id);
+      if (!request) return; // Cancelled
+      pending.delete(id);
+      if (positions) {
+        request.resolve(positions);
+      } else {
+        request.reject(new Error(error ?? 'Layout failed'));
+      }
+    };
+    worker.onerror = () => {
+      // Fail everything in flight and solve on the main thread from now on
+      workerFailed = true;
+      worker?.terminate();
+      worker = null;
+      pending.forEach(request => request.reject(new Error('Layout worker crashed')));
+      pending.clear();
+    };
+  } catch {
+    workerFailed = true;
+    worker = null;
+  }
+  return worker;
+}
+
+/**
+ * Packs furniture into a layout request
+ */
+export function packLayoutRequest(furniture: Furniture[]): LayoutRequest {
+  const count = furniture.length;
+  const categories = new Uint8Array(count);
+  const sizes = new Float32Array(count * 2);
+  const positions = new Float32Array(count * 2);
+  furniture.forEach((item, i) => {
+    categories[i] = categoryCode(item.category);
+    sizes[i * 2] = item.dimensions.width;
+    sizes[i * 2 + 1] = item.dimensions.depth;
+    positions[i * 2] = item.position.x;
+    positions[i * 2 + 1] = item.position.z;
+  });
+  return { count, categories, sizes, positions };
+}
+
+/**
+ * Applies solved positions and turns, reusing items that did not move
+ */
+export function applyLayout(furniture: Furniture[], positions: Float32Array): Furniture[] {
+  return furniture.map((item, i) => {
+    // Compare at Float32 precision, the precision the solver works in
+    const x = positions[i * LAYOUT_STRIDE];
+    const z = positions[i * LAYOUT_STRIDE + 1];
+    const rotationY = positions[i * LAYOUT_STRIDE + 2];
+    if (
+      Math.fround(item.position.x) === x &&
+      Math.fround(item.position.z) === z &&
+      Math.fround(item.rotationY ?? 0) === rotationY
+    ) {
+      return item;
+    }
+    return { ...item, position: { ...item.position, x, z }, rotationY };
+  });
+}
+
+function solveInWorker(
+  target: Worker,
+  request: LayoutRequest,
+  options: LayoutOptions | undefined,
+  signal?: AbortSignal
+): Promise<Float32Array> {
+  return new Promise((resolve, reject) => {
+    const id = ++nextId;
+    const onAbort = () => {
+      // The worker cannot be interrupted mid-solve; drop its answer instead
+      pending.delete(id);
+      reject(createAbortError());
+    };
+    signal?.addEventListener('abort', onAbort, { once: true });
+    pending.set(id, {
+      resolve: positions => {
+        signal?.removeEventListener('abort', onAbort);
+        resolve(positions);
+      },
+      reject: error => {
+        signal?.removeEventListener('abort', onAbort);
+        reject(error);
+      },
+    });
+
+    const message: LayoutWorkerRequest = { id, request, options };
+    target.postMessage(message, [
+      request.categories.buffer,
+      request.sizes.buffer,
+      request.positions.buffer,
+    ]);
+  });
+}
+
+/**
+ * Lays out furniture inside the room without blocking the main thread
+ */
+export async function layoutFurniture(
+  furniture: Furniture[],
+  options: LayoutOptions & { signal?: AbortSignal } = {}
+): Promise<Furniture[]> {
+  const { signal, ...layoutOptions } = options;
+  throwIfAborted(signal);
+  if (furniture.length === 0) return furniture;
+
+  const target = getWorker();
+  let positions: Float32Array;
+  if (target) {
+    try {
+      positions = await solveInWorker(target, packLayoutRequest(furniture), layoutOptions, signal);
+    } catch (error) {
+      if (signal?.aborted) throw error;
+      // Worker died during this solve; the request buffers were transferred
+      positions = solveLayout(packLayoutRequest(furniture), layoutOptions);
+    }
+  } else {
+    positions = solveLayout(packLayoutRequest(furniture), layoutOptions);
+  }
+
+  throwIfAborted(signal);
+  return applyLayout(furniture, positions);
+}
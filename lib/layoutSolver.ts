@@ -0,0 +1,232 @@
+import { Rect, SpatialGrid, rectsOverlap } from './spatialIndex';
+import { ROOM_DEPTH, ROOM_WIDTH } from './roomStats';
+import { categoryCode } from './furnitureCategories';
+
+/**
+ * Constraint-based furniture layout
+ *
+ * Places items one at a time, largest and most constrained first, at the
+ * free spot nearest to where they would like to be:
+ * - every item stays inside the room, `wallClearance` away from the walls
+ * - cabinets and shelves are pushed flat against the nearest back or side
+ *   wall; the front (+z) is the side the camera looks in from, so its wall
+ *   is culled and an item against it would have its back to the room
+ * - chairs are seated around the nearest table, turned to face it
+ * - items keep a `walkway` gap from one another, except within a table group
+ * - nothing overlaps, as long as the room has space for it
+ *
+ * Input and output are flat typed arrays with no DOM dependencies, so the
+ * solver can run in a worker and hand its result back as a transfer.
+ */
+
+/**
+ * Packed layout problem; one entry per item in every array
+ */
+export interface LayoutRequest {
+  count: number;
+  categories: Uint8Array; // Category codes (lib/furnitureCategories.ts)
+  sizes: Float32Array; // width, depth
+  positions: Float32Array; // Preferred x, z
+}
+
+export interface LayoutOptions {
+  roomWidth?: number;
+  roomDepth?: number;
+  wallClearance?: number; // Minimum gap between any item and a wall
+  walkway?: number; // Minimum gap between unrelated items
+  groupGap?: number; // Gap between a table and its chairs
+  searchStep?: number; // Spacing of candidate positions
+}
+
+const TABLE = categoryCode('table');
+const CHAIR = categoryCode('chair');
+const WALL_HUGGING = new Set([categoryCode('cabinet'), categoryCode('shelf')]);
+const LARGE = new Set([categoryCode('sofa'), categoryCode('bed')]);
+
+// Unturned chairs face +z: their backrest is at -z (lib/furnitureParts.ts)
+const FACE_PLUS_Z = 0;
+const FACE_MINUS_Z = Math.PI;
+const FACE_PLUS_X = Math.PI / 2;
+const FACE_MINUS_X = -Math.PI / 2;
+
+/**
+ * Values per item in a solved layout: x, z and rotationY
+ */
+export const LAYOUT_STRIDE = 3;
+
+/**
+ * Solves a layout; returns x, z and rotationY per item
+ */
+export function solveLayout(request: LayoutRequest, options: LayoutOptions = {}): Float32Array {
+  const {
+    roomWidth = ROOM_WIDTH,
+    roomDepth = ROOM_DEPTH,
+    wallClearance = 0.1,
+    walkway = 0.6,
+    groupGap = 0.05,
+    searchStep = 0.25,
+  } = options;
+  const { count, categories, sizes, positions } = request;
+  const result = new Float32Array(count * LAYOUT_STRIDE);
+
+  // Items turned a quarter turn take up depth × width on the floor
+  const sideways = new Uint8Array(count);
+  const width = (i: number) => sizes[i * 2 + sideways[i]];
+  const depth = (i: number) => sizes[i * 2 + 1 - sideways[i]];
+
+  // Seat each chair at the nearest table; tables with chairs become anchors
+  const anchorOf = new Int32Array(count).fill(-1);
+  const members = new Map<number, number[]>();
+  for (let i = 0; i < count; i++) {
+    if (categories[i] !== CHAIR) continue;
+    let nearest = -1;
+    let nearestDistance = Infinity;
+    for (let j = 0; j < count; j++) {
+      if (categories[j] !== TABLE) continue;
+      const dx = positions[j * 2] - positions[i * 2];
+      const dz = positions[j * 2 + 1] - positions[i * 2 + 1];
+      const distance = dx * dx + dz * dz;
+      if (distance < nearestDistance) {
+        nearest = j;
+        nearestDistance = distance;
+      }
+    }
+    if (nearest !== -1) {
+      anchorOf[i] = nearest;
+      const group = members.get(nearest) ?? [];
+      group.push(i);
+      members.set(nearest, group);
+    }
+  }
+  const groupOf = (i: number) => (anchorOf[i] !== -1 ? anchorOf[i] : members.has(i) ? i : -1);
+
+  // Most constrained first; chairs last so their table is already placed
+  const rank = (i: number) => {
+    if (anchorOf[i] !== -1) return 4;
+    if (WALL_HUGGING.has(categories[i])) return 0;
+    if (members.has(i)) return 1;
+    if (LARGE.has(categories[i])) return 2;
+    return 3;
+  };
+  const order = Array.from({ length: count }, (_, i) => i).sort(
+    (a, b) => rank(a) - rank(b) || width(b) * depth(b) - width(a) * depth(a) || a - b
+  );
+
+  const halfRoomWidth = roomWidth / 2;
+  const halfRoomDepth = roomDepth / 2;
+  const clampAxis = (value: number, half: number, halfSize: number) => {
+    const limit = half - wallClearance - halfSize;
+    return limit <= 0 ? 0 : Math.min(Math.max(value, -limit), limit);
+  };
+  const rectAt = (i: number, x: number, z: number, margin = 0): Rect => ({
+    minX: x - width(i) / 2 - margin,
+    minZ: z - depth(i) / 2 - margin,
+    maxX: x + width(i) / 2 + margin,
+    maxZ: z + depth(i) / 2 + margin,
+  });
+
+  const grid = new SpatialGrid(Math.max(searchStep * 2, 0.5));
+
+  const fits = (i: number, x: number, z: number) => {
+    const group = groupOf(i);
+    const hits = grid.query(rectAt(i, x, z, walkway));
+    return hits.every(hit => {
+      const other = Number(hit);
+      // Tables and their chairs only need to avoid touching
+      return group !== -1 && groupOf(other) === group && !rectsOverlap(rectAt(i, x, z, groupGap), grid.get(hit)!);
+    });
+  };
+
+  // Nearest free spot to (x, z), scanning square rings of candidates
+  const place = (i: number, targetX: number, targetZ: number) => {
+    const halfWidth = width(i) / 2;
+    const halfDepth = depth(i) / 2;
+    const clampX = (x: number) => clampAxis(x, halfRoomWidth, halfWidth);
+    const clampZ = (z: number) => clampAxis(z, halfRoomDepth, halfDepth);
+
+    const startX = clampX(targetX);
+    const startZ = clampZ(targetZ);
+    let placedX = startX;
+    let placedZ = startZ;
+
+    const tryAt = (x: number, z: number) => {
+      const cx = clampX(x);
+      const cz = clampZ(z);
+      if (!fits(i, cx, cz)) return false;
+      placedX = cx;
+      placedZ = cz;
+      return true;
+    };
+
+    if (!tryAt(startX, startZ)) {
+      const maxRings = Math.ceil(Math.max(roomWidth, roomDepth) / searchStep);
+      search: for (let ring = 1; ring <= maxRings; ring++) {
+        const reach = ring * searchStep;
+        for (let k = -ring; k <= ring; k++) {
+          const along = k * searchStep;
+          if (
+            tryAt(startX + along, startZ - reach) ||
+            tryAt(startX + along, startZ + reach) ||
+            tryAt(startX - reach, startZ + along) ||
+            tryAt(startX + reach, startZ + along)
+          ) {
+            break search;
+          }
+        }
+      }
+      // No free spot at all: keep the clamped target so it stays in the room
+    }
+
+    result[i * LAYOUT_STRIDE] = placedX;
+    result[i * LAYOUT_STRIDE + 1] = placedZ;
+    grid.insert(String(i), rectAt(i, placedX, placedZ));
+  };
+
+  order.forEach(i => {
+    let x = positions[i * 2];
+    let z = positions[i * 2 + 1];
+
+    let rotationY = 0;
+
+    if (WALL_HUGGING.has(categories[i])) {
+      // Flush against whichever wall is closest, never the open front
+      const toSide = halfRoomWidth - Math.abs(x);
+      const toBack = halfRoomDepth + z;
+      if (toSide < toBack) {
+        // Turned to face into the room, so its back lies along the side wall
+        x = Math.sign(x || 1) * halfRoomWidth;
+        rotationY = x < 0 ? FACE_PLUS_X : FACE_MINUS_X;
+        sideways[i] = 1;
+      } else {
+        z = -halfRoomDepth;
+      }
+    } else if (anchorOf[i] !== -1) {
+      // Alternate chairs between the table's two long sides
+      const anchor = anchorOf[i];
+      const group = members.get(anchor)!;
+      const seat = group.indexOf(i);
+      const perSide = Math.ceil(group.length / 2);
+      const side = seat % 2 === 0 ? -1 : 1;
+      const slot = Math.floor(seat / 2) - (perSide - 1) / 2;
+
+      const anchorX = result[anchor * LAYOUT_STRIDE];
+      const anchorZ = result[anchor * LAYOUT_STRIDE + 1];
+      // Each chair turns to face the table across its side
+      if (width(anchor) >= depth(anchor)) {
+        rotationY = side < 0 ? FACE_PLUS_Z : FACE_MINUS_Z;
+        x = anchorX + slot * (width(anchor) / perSide);
+        z = anchorZ + side * (depth(anchor) / 2 + depth(i) / 2 + groupGap * 2);
+      } else {
+        rotationY = side < 0 ? FACE_PLUS_X : FACE_MINUS_X;
+        sideways[i] = 1;
+        x = anchorX + side * (width(anchor) / 2 + width(i) / 2 + groupGap * 2);
+        z = anchorZ + slot * (depth(anchor) / perSide);
+      }
+    }
+
+    place(i, x, z);
+    result[i * LAYOUT_STRIDE + 2] = rotationY;
+  });
+
+  return result;
+}
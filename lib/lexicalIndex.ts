@@ -0,0 +1,127 @@
+import { FurnitureCategory } from '@/types/furniture';
+import { BinaryCatalogue } from './binaryCatalogue';
+import { tokenize } from './embedding';
+import { FURNITURE_CATEGORIES, categoryCode } from './furnitureCategories';
+import { SearchHit, TopK } from './vectorIndex';
+
+/**
+ * BM25 inverted index over catalogue text
+ *
+ * Indexes the name, category and description of every row with per-field
+ * weights (a simple BM25F). Postings are frozen into typed arrays after
+ * the build, so a query only touches the rows that share a term with it.
+ * Rows per category are kept as a second set of postings, pre-sorted by
+ * confidence, for category-filtered retrieval without a catalogue scan.
+ */
+
+const K1 = 1.2;
+const B = 0.75;
+
+// Term frequency weight of each field; names say the most about an item
+const FIELD_WEIGHTS = { name: 2, category: 1.5, description: 1 };
+
+interface Postings {
+  rows: Uint32Array;
+  weights: Float32Array; // Field-weighted term frequency per row
+  idf: number;
+}
+
+export class LexicalIndex {
+  readonly count: number;
+  private readonly postings = new Map<string, Postings>();
+  private readonly lengthNorm: Float32Array; // 1 - b + b * length / average
+  private readonly categoryPostings: Uint32Array[];
+  // Scratch score accumulator, one slot per row
+  private readonly scores: Float32Array;
+
+  constructor(catalogue: BinaryCatalogue) {
+    const { count } = catalogue;
+    this.count = count;
+    this.scores = new Float32Array(count);
+
+    const building = new Map<string, { rows: number[]; weights: number[] }>();
+    const lengths = new Float32Array(count);
+    let totalLength = 0;
+
+    for (let row = 0; row < count; row++) {
+      const termWeights = new Map<string, number>();
+      const addField = (text: string | undefined, weight: number) => {
+        if (!text) return;
+        tokenize(text).forEach(token => {
+          termWeights.set(token, (termWeights.get(token) ?? 0) + weight);
+          lengths[row] += weight;
+        });
+      };
+      addField(catalogue.name(row), FIELD_WEIGHTS.name);
+      addField(catalogue.category(row), FIELD_WEIGHTS.category);
+      addField(catalogue.description(row), FIELD_WEIGHTS.description);
+      totalLength += lengths[row];
+
+      termWeights.forEach((weight, term) => {
+        let list = building.get(term);
+        if (!list) {
+          list = { rows: [], weights: [] };
+          building.set(term, list);
+        }
+        list.rows.push(row);
+        list.weights.push(weight);
+      });
+    }
+
+    const averageLength = count > 0 ? totalLength / count || 1 : 1;
+    this.lengthNorm = lengths.map(length => 1 - B + (B * length) / averageLength);
+
+    building.forEach((list, term) => {
+      const df = list.rows.length;
+      this.postings.set(term, {
+        rows: Uint32Array.from(list.rows),
+        weights: Float32Array.from(list.weights),
+        idf: Math.log(1 + (count - df + 0.5) / (df + 0.5)),
+      });
+    });
+
+    const byCategory: number[][] = FURNITURE_CATEGORIES.map(() => []);
+    for (let row = 0; row < count; row++) byCategory[catalogue.categories[row]].push(row);
+    this.categoryPostings = byCategory.map(rows =>
+      Uint32Array.from(rows.sort((a, b) => catalogue.confidence[b] - catalogue.confidence[a]))
+    );
+  }
+
+  get termCount(): number {
+    return this.postings.size;
+  }
+
+  /**
+   * Top `k` rows by BM25 score for already tokenized query terms
+   */
+  search(terms: string[], k: number): SearchHit[] {
+    const { scores, lengthNorm } = this;
+    const touched: number[] = [];
+
+    new Set(terms).forEach(term => {
+      const list = this.postings.get(term);
+      if (!list) return;
+      const { rows, weights, idf } = list;
+      for (let i = 0; i < rows.length; i++) {
+        const row = rows[i];
+        const tf = weights[i];
+        if (scores[row] === 0) touched.push(row);
+        scores[row] += (idf * tf * (K1 + 1)) / (tf + K1 * lengthNorm[row]);
+      }
+    });
+
+    const top = new TopK(k);
+    touched.forEach(row => {
+      top.offer(row, scores[row]);
+      scores[row] = 0;
+    });
+    return top.drain();
+  }
+
+  /**
+   * Rows in `category`, highest confidence first
+   */
+  categoryRows(category: FurnitureCategory): Uint32Array {
+    return this.categoryPostings[categoryCode(category)];
+  }
+}
@@ -0,0 +1,121 @@
+/**
+ * Bounded least-recently-used cache with expiry
+ *
+ * Plain Map-based implementation with no DOM or Node dependencies, so the
+ * same cache works in the browser and in route handlers. Map iteration
+ * order doubles as the recency list: reads move an entry to the end and
+ * evictions take from the front.
+ */
+
+export interface LRUCacheOptions<V> {
+  maxEntries?: number;
+  maxBytes?: number; // Memory cap, measured with `sizeOf`
+  ttlMs?: number; // Entries older than this are treated as misses
+  sizeOf?: (value: V) => number;
+  now?: () => number; // Clock, injectable for tests and benchmarks
+}
+
+export interface LRUCacheStats {
+  hits: number;
+  misses: number;
+  evictions: number;
+  entries: number;
+  bytes: number;
+}
+
+interface CacheEntry<V> {
+  value: V;
+  bytes: number;
+  expiresAt: number;
+}
+
+export class LRUCache<K, V> {
+  private entries = new Map<K, CacheEntry<V>>();
+  private readonly maxEntries: number;
+  private readonly maxBytes: number;
+  private readonly ttlMs: number;
+  private readonly sizeOf: (value: V) => number;
+  private readonly now: () => number;
+
+  private bytes = 0;
+  private hits = 0;
+  private misses = 0;
+  private evictions = 0;
+
+  constructor(options: LRUCacheOptions<V> = {}) {
+    this.maxEntries = options.maxEntries ?? 100;
+    this.maxBytes = options.maxBytes ?? Infinity;
+    this.ttlMs = options.ttlMs ?? Infinity;
+    this.sizeOf = options.sizeOf ?? (() => 0);
+    this.now = options.now ?? Date.now;
+  }
+
+  /**
+   * Returns a live entry and marks it most recently used
+   */
+  get(key: K): V | undefined {
+    const entry = this.entries.get(key);
+    if (!entry || entry.expiresAt <= this.now()) {
+      if (entry) this.remove(key, entry);
+      this.misses++;
+      return undefined;
+    }
+
+    this.entries.delete(key);
+    this.entries.set(key, entry);
+    this.hits++;
+    return entry.value;
+  }
+
+  /**
+   * Checks for a live entry without touching recency or counters
+   */
+  has(key: K): boolean {
+    const entry = this.entries.get(key);
+    return entry !== undefined && entry.expiresAt > this.now();
+  }
+
+  set(key: K, value: V) {
+    const existing = this.entries.get(key);
+    if (existing) this.remove(key, existing);
+
+    const bytes = this.sizeOf(value);
+    if (bytes > this.maxBytes) return; // Would evict everything and still not fit
+
+    this.entries.set(key, { value, bytes, expiresAt: this.now() + this.ttlMs });
+    this.bytes += bytes;
+
+    while (this.entries.size > this.maxEntries || this.bytes > this.maxBytes) {
+      const oldest = this.entries.keys().next().value as K;
+      this.remove(oldest, this.entries.get(oldest)!);
+      this.evictions++;
+    }
+  }
+
+  delete(key: K): boolean {
+    const entry = this.entries.get(key);
+    if (!entry) return false;
+    this.remove(key, entry);
+    return true;
+  }
+
+  clear() {
+    this.entries.clear();
+    this.bytes = 0;
+  }
+
+  get stats(): LRUCacheStats {
+    return {
+      hits: this.hits,
+      misses: this.misses,
+      evictions: this.evictions,
+      entries: this.entries.size,
+      bytes: this.bytes,
+    };
+  }
+
+  private remove(key: K, entry: CacheEntry<V>) {
+    this.entries.delete(key);
+    this.bytes -= entry.bytes;
+  }
+}
@@ -1,6 +1,34 @@
 import { Furniture, RAGRetrievalResult } from '@/types/furniture';
-import { MOCK_FURNITURE_DATABASE, JAPANESE_FURNITURE_DATABASE } from './furnitureData';
-import { RoomStyle } from '@/types/chat';
+import { MOCK_FURNITURE_DATABASE } from './furnitureData';
+import { StyleClassification } from '@/types/chat';
+import { classifyRoomStyle } from './styleDetection';
+import { BinaryCatalogue } from './binaryCatalogue';
+import { CATALOGUE_SHARDS, getCatalogueManifest } from './catalogueManifest';
+import { DEFAULT_SHARD, STYLE_SHARDS } from './embeddingShards';
+import {
+  CatalogueIndex,
+  buildCatalogueIndex,
+  categoryRows,
+  collectHits,
+  rowsToFurniture,
+  searchCatalogueIndex,
+} from './hybridSearch';
+import { LRUCache, LRUCacheStats } from './lruCache';
+import { readPrebuiltShard } from './prebuiltEmbeddings';
+import {
+  RetrievalBackend,
+  RetrievalOptions,
+  deadlineFor,
+  now,
+  throwIfAborted,
+  withResultCache,
+  withSyntheticLatency,
+} from './retrievalBackend';
+
+// Style detection and room statistics live in their own modules so that
+// client components can use them without bundling the catalogue
+export { classifyRoomStyle, detectRoomStyle } from './styleDetection';
+export { calculateRoomCoverage } from './roomStats';
 
 /**
  * Simulates a RAG (Retrieval-Augmented Generation) system for furniture retrieval
@@ -11,152 +39,177 @@ import { RoomStyle } from '@/types/chat';
  * 4. Return confidence-scored results
  */
 
+// Shards are encoded and indexed lazily, once each
+const shardIndexes = new Map<string, CatalogueIndex>();
+
 /**
- * Simulates network delay for realistic retrieval experience
+ * Gets the columnar catalogue and indexes for a catalogue shard
+ * Item vectors come from the shard prebuilt before `next build`; they are
+ * only embedded here when that file is missing or older than the catalogue.
+ * Unknown shards fall back to the default one.
  */
-const simulateDelay = (ms: number = 1500): Promise<void> => {
-  return new Promise(resolve => setTimeout(resolve, ms));
-};
+function getShardIndex(name: string): CatalogueIndex {
+  const shard = CATALOGUE_SHARDS[name] ? name : DEFAULT_SHARD;
+  let catalogueIndex = shardIndexes.get(shard);
+  if (!catalogueIndex) {
+    const catalogue = BinaryCatalogue.fromItems(CATALOGUE_SHARDS[shard]);
+    const version = getCatalogueManifest().shards.find(entry => entry.shard === shard)?.version;
+    const prebuilt = version ? readPrebuiltShard(shard, version, catalogue.count) : null;
+    if (!prebuilt) console.warn(`No current prebuilt embeddings for shard "${shard}", embedding at runtime`);
+    catalogueIndex = buildCatalogueIndex(catalogue, prebuilt ?? undefined);
+    shardIndexes.set(shard, catalogueIndex);
+  }
+  return catalogueIndex;
+}
 
 /**
- * Detects room style from user query
- * Uses simple keyword matching (in real implementation, would use NLP/LLM)
+ * In-process hybrid retrieval backend over catalogue indexes
+ * Vector and BM25 search generate candidates, a bounded re-ranker orders
+ * them; returns the best results found before the latency budget runs out.
+ * `indexFor` maps a catalogue shard name to its indexes, so benchmarks can
+ * swap in synthetic catalogues.
  */
-export function detectRoomStyle(query: string): RoomStyle {
-  const lowerQuery = query.toLowerCase();
+export function createCatalogueBackend(indexFor: (shard: string) => CatalogueIndex): RetrievalBackend {
+  return {
+    async retrieve(request, options = {}) {
+      const deadline = deadlineFor(options);
+      const { query, maxResults, categories } = request;
+
+      if (categories) {
+        throwIfAborted(options.signal);
+        const catalogueIndex = indexFor(DEFAULT_SHARD);
+        return {
+          furniture: rowsToFurniture(
+            catalogueIndex.catalogue,
+            categoryRows(catalogueIndex, categories),
+            options.onItem
+          ),
+          timestamp: new Date(),
+          query,
+        };
+      }
+
+      // Classify the room style once; the result carries it back to the caller
+      const classifyStart = now();
+      const { style, scores } = request.classification ?? classifyRoomStyle(query);
+      const classifyTime = request.classification ? undefined : now() - classifyStart;
+
+      const catalogueIndex = indexFor(STYLE_SHARDS[style]);
+      // Hits are materialized, and passed on, as soon as their rank is final
+      const furniture: Furniture[] = [];
+      const { complete, timings } = await searchCatalogueIndex(
+        catalogueIndex,
+        query,
+        maxResults,
+        deadline,
+        options.signal,
+        collectHits(catalogueIndex.catalogue, furniture, options.onItem)
+      );
+
+      return {
+        furniture,
+        timestamp: new Date(),
+        query,
+        partial: !complete,
+        style,
+        styleScores: scores,
+        timings: { classify: classifyTime, ...timings },
+      };
+    },
+  };
+}
 
-  if (lowerQuery.includes('japanese') || lowerQuery.includes('japan') ||
-      lowerQuery.includes('zen') || lowerQuery.includes('tatami')) {
-    return 'japanese';
-  }
-  if (lowerQuery.includes('minimalist') || lowerQuery.includes('minimal')) {
-    return 'minimalist';
-  }
-  if (lowerQuery.includes('scandinavian') || lowerQuery.includes('nordic')) {
-    return 'scandinavian';
-  }
-  if (lowerQuery.includes('industrial')) {
-    return 'industrial';
-  }
-  if (lowerQuery.includes('traditional')) {
-    return 'traditional';
-  }
+/**
+ * Backend over the built-in furniture databases
+ */
+export const localVectorBackend: RetrievalBackend = createCatalogueBackend(getShardIndex);
+
+// Optional artificial delay for demos, e.g. NEXT_PUBLIC_SYNTHETIC_LATENCY_MS=150
+// It comes out of the latency budget and is capped at it, so delays near the
+// 300 ms default leave the search too little time and return partial results
+const SYNTHETIC_LATENCY_MS = Number(process.env.NEXT_PUBLIC_SYNTHETIC_LATENCY_MS ?? 0);
 
-  // Default to modern
-  return 'modern';
+/**
+ * Rough in-memory size of a retrieval result, for the cache's memory cap
+ */
+function estimateResultBytes(result: RAGRetrievalResult): number {
+  const textBytes = (text?: string) => (text ? text.length * 2 : 0);
+  return result.furniture.reduce(
+    (bytes, item) =>
+      bytes + 256 + textBytes(item.id) + textBytes(item.name) + textBytes(item.description),
+    64 + textBytes(result.query)
+  );
 }
 
 /**
- * Gets furniture database based on detected style
+ * Shared result cache in front of the active backend
  */
-function getFurnitureByStyle(style: RoomStyle): Omit<Furniture, 'visible'>[] {
-  switch (style) {
-    case 'japanese':
-      return JAPANESE_FURNITURE_DATABASE;
-    case 'modern':
-    case 'minimalist':
-    case 'scandinavian':
-    case 'industrial':
-    case 'traditional':
-    default:
-      return MOCK_FURNITURE_DATABASE;
-  }
+export const retrievalCache = new LRUCache<string, RAGRetrievalResult>({
+  maxEntries: 64,
+  maxBytes: 2 * 1024 * 1024,
+  ttlMs: 5 * 60 * 1000,
+  sizeOf: estimateResultBytes,
+});
+
+let activeBackend: RetrievalBackend = withResultCache(
+  SYNTHETIC_LATENCY_MS > 0
+    ? withSyntheticLatency(localVectorBackend, SYNTHETIC_LATENCY_MS)
+    : localVectorBackend,
+  retrievalCache
+);
+
+/**
+ * Replaces the backend used by retrieveFurniture and retrieveFurnitureByCategory
+ * Cached results from the previous backend are dropped
+ */
+export function setRetrievalBackend(backend: RetrievalBackend) {
+  retrievalCache.clear();
+  activeBackend = withResultCache(backend, retrievalCache);
+}
+
+/**
+ * Hit/miss counters and memory use of the retrieval cache
+ */
+export function getRetrievalCacheStats(): LRUCacheStats {
+  return retrievalCache.stats;
 }
 
 /**
  * Mock RAG retrieval function
- * Simulates retrieving furniture based on a query
+ * Retrieves furniture based on a query through the active backend
  *
  * @param query - User query (e.g., "modern living room", "japanese style room")
  * @param maxResults - Maximum number of results to return
+ * @param options - Latency budget and abort signal for this call
+ * @param classification - Style classification of `query`, when the caller already has it
  * @returns RAGRetrievalResult with furniture items and metadata
  */
-export async function retrieveFurniture(
+export function retrieveFurniture(
   query: string = 'HDB living room furniture',
-  maxResults: number = 10
+  maxResults: number = 10,
+  options?: RetrievalOptions,
+  classification?: StyleClassification
 ): Promise<RAGRetrievalResult> {
-  // Simulate network delay
-  await simulateDelay(1500);
-
-  // Detect room style from query
-  const style = detectRoomStyle(query);
-
-  // Get appropriate furniture database
-  const furnitureDatabase = getFurnitureByStyle(style);
-
-  // In a real implementation, this would:
-  // 1. Embed the query using an embedding model
-  // 2. Perform vector similarity search
-  // 3. Re-rank results using LLM
-  // For now, we'll return all furniture sorted by confidence score
-
-  const retrievedFurniture: Furniture[] = furnitureDatabase
-    .slice(0, maxResults)
-    .map(item => ({
-      ...item,
-      visible: true, // All items visible by default
-    }))
-    .sort((a, b) => b.confidenceScore - a.confidenceScore);
-
-  return {
-    furniture: retrievedFurniture,
-    timestamp: new Date(),
-    query,
-  };
+  return activeBackend.retrieve({ query, maxResults, classification }, options);
 }
 
 /**
- * Simulates a targeted retrieval for specific furniture categories
+ * Targeted retrieval for specific furniture categories
  *
  * @param categories - Array of furniture categories to retrieve
+ * @param options - Latency budget and abort signal for this call
  * @returns RAGRetrievalResult with filtered furniture items
  */
-export async function retrieveFurnitureByCategory(
-  categories: string[]
+export function retrieveFurnitureByCategory(
+  categories: string[],
+  options?: RetrievalOptions
 ): Promise<RAGRetrievalResult> {
-  await simulateDelay(1000);
-
-  const retrievedFurniture: Furniture[] = MOCK_FURNITURE_DATABASE
-    .filter(item => categories.includes(item.category))
-    .map(item => ({
-      ...item,
-      visible: true,
-    }))
-    .sort((a, b) => b.confidenceScore - a.confidenceScore);
-
-  return {
-    furniture: retrievedFurniture,
-    timestamp: new Date(),
-    query: `Categories: ${categories.join(', ')}`,
-  };
-}
-
-/**
- * Calculates room coverage statistics
- * Useful for understanding space utilization
- */
-export function calculateRoomCoverage(
-  furniture: Furniture[],
-  roomWidth: number,
-  roomDepth: number
-): {
-  totalFootprint: number;
-  coveragePercentage: number;
-  itemCount: number;
-} {
-  const visibleFurniture = furniture.filter(f => f.visible);
-
-  const totalFootprint = visibleFurniture.reduce(
-    (sum, item) => sum + (item.dimensions.width * item.dimensions.depth),
-    0
+  return activeBackend.retrieve(
+    {
+      query: `Categories: ${categories.join(', ')}`,
+      maxResults: MOCK_FURNITURE_DATABASE.length,
+      categories,
+    },
+    options
   );
-
-  const roomArea = roomWidth * roomDepth;
-  const coveragePercentage = (totalFootprint / roomArea) * 100;
-
-  return {
-    totalFootprint: Math.round(totalFootprint * 100) / 100,
-    coveragePercentage: Math.round(coveragePercentage * 10) / 10,
-    itemCount: visibleFurniture.length,
-  };
 }
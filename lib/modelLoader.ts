@@ -0,0 +1,87 @@
+import * as THREE from 'three';
+import { GLTFLoader } from 'three/examples/jsm/loaders/GLTFLoader.js';
+import { DRACOLoader } from 'three/examples/jsm/loaders/DRACOLoader.js';
+import { MeshoptDecoder } from 'three/examples/jsm/libs/meshopt_decoder.module.js';
+import { Dimensions, Furniture, ModelLod } from '@/types/furniture';
+
+/**
+ * Compressed glTF loading for vendor furniture models
+ *
+ * Draco and Meshopt geometry is decoded in worker pools, so parsing a large
+ * model does not block the render loop. Loaded scenes are cached by URL
+ * through react-three-fiber's loader cache and cloned per item, sharing
+ * geometry and materials; disposeModel frees them once no item uses them.
+ */
+
+export const DRACO_DECODER_PATH = 'https://www.gstatic.com/draco/versioned/decoders/1.5.7/';
+const DECODER_WORKERS = 2;
+
+let dracoLoader: DRACOLoader | null = null;
+let meshoptWorkersStarted = false;
+
+/**
+ * Loader extension for useLoader(GLTFLoader, url, configureGltfLoader)
+ */
+export function configureGltfLoader(loader: GLTFLoader) {
+  if (!dracoLoader) {
+    dracoLoader = new DRACOLoader().setDecoderPath(DRACO_DECODER_PATH).setWorkerLimit(DECODER_WORKERS);
+  }
+  if (!meshoptWorkersStarted) {
+    MeshoptDecoder.useWorkers(DECODER_WORKERS);
+    meshoptWorkersStarted = true;
+  }
+  loader.setDRACOLoader(dracoLoader);
+  loader.setMeshoptDecoder(MeshoptDecoder);
+}
+
+/**
+ * Model levels for an item, nearest first; empty when it has no model
+ */
+export function modelLevels(item: Furniture): ModelLod[] {
+  if (!item.modelUrl) return [];
+  const lods = (item.modelLods ?? []).slice().sort((a, b) => a.distance - b.distance);
+  return [{ url: item.modelUrl, distance: 0 }, ...lods.filter(lod => lod.distance > 0)];
+}
+
+/**
+ * Frees the geometries, materials and textures of a loaded scene
+ */
+export function disposeModel(root: THREE.Object3D) {
+  root.traverse(object => {
+    const mesh = object as THREE.Mesh;
+    if (!mesh.isMesh) return;
+    mesh.geometry.dispose();
+    const materials = Array.isArray(mesh.material) ? mesh.material : [mesh.material];
+    materials.forEach(material => {
+      Object.values(material).forEach(value => {
+        if (value instanceof THREE.Texture) value.dispose();
+      });
+      material.dispose();
+    });
+  });
+}
+
+const scratchBox = new THREE.Box3();
+const scratchSize = new THREE.Vector3();
+const scratchCenter = new THREE.Vector3();
+
+/**
+ * Clones a loaded scene, centred on the origin and scaled to the item's
+ * catalogue dimensions, so models line up with the placeholder they replace
+ */
+export function fitModelToDimensions(source: THREE.Object3D, dimensions: Dimensions): THREE.Group {
+  const model = source.clone();
+  scratchBox.setFromObject(model);
+  scratchBox.getSize(scratchSize);
+  scratchBox.getCenter(scratchCenter);
+  model.position.sub(scratchCenter);
+
+  const fitted = new THREE.Group();
+  fitted.add(model);
+  fitted.scale.set(
+    dimensions.width / (scratchSize.x || 1),
+    dimensions.height / (scratchSize.y || 1),
+    dimensions.depth / (scratchSize.z || 1)
+  );
+  return fitted;
+}
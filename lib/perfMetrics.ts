@@ -0,0 +1,176 @@
+import type { WebGLInfo } from 'three';
+import { RetrievalTimings } from '@/types/furniture';
+
+/**
+ * Client performance metrics for the viewer and retrieval
+ *
+ * Frame times and renderer counters are recorded from inside the canvas,
+ * retrieval stage timings after each retrieval. Everything lands in plain
+ * module state so recording never re-renders React; the overlay polls a
+ * snapshot instead. The same numbers go to the User Timing API (visible in
+ * the Performance panel and to RUM scripts) and, when
+ * NEXT_PUBLIC_METRICS_ENDPOINT is set, to a beacon on page hide.
+ */
+
+export const METRICS_ENDPOINT = process.env.NEXT_PUBLIC_METRICS_ENDPOINT ?? '';
+
+export const RETRIEVAL_STAGES = ['classify', 'search', 'rank', 'layout'] as const;
+export type RetrievalStage = (typeof RETRIEVAL_STAGES)[number];
+
+const MARK_PREFIX = 'decoplan';
+const FRAME_SAMPLES = 240;
+// A frame-stats mark is emitted once per this many recorded frames
+const FRAME_MARK_INTERVAL = FRAME_SAMPLES;
+const RETRIEVAL_HISTORY = 50;
+
+export interface Percentiles {
+  p50: number;
+  p95: number;
+  p99: number;
+  samples: number;
+}
+
+export interface RendererStats {
+  drawCalls: number;
+  triangles: number;
+  geometries: number;
+  textures: number;
+}
+
+export interface RetrievalSample extends RetrievalTimings {
+  total: number; // Wall time seen by the client, ms
+  timestamp: number; // Date.now()
+}
+
+export interface PerfSnapshot {
+  frames: Percentiles;
+  renderer: RendererStats;
+  lastRetrieval: RetrievalSample | null;
+  retrievalP95: Record<RetrievalStage | 'total', number>;
+}
+
+const frameTimes = new Float32Array(FRAME_SAMPLES);
+let frameCount = 0; // Total recorded, so the window is the last FRAME_SAMPLES
+const renderer: RendererStats = { drawCalls: 0, triangles: 0, geometries: 0, textures: 0 };
+const retrievals: RetrievalSample[] = [];
+// Retrievals not yet sent with a beacon
+let unsentRetrievals: RetrievalSample[] = [];
+
+const hasUserTiming = () => typeof performance !== 'undefined' && typeof performance.measure === 'function';
+
+/**
+ * Nearest-rank percentiles; all zero for no samples
+ */
+export function percentiles(values: ArrayLike<number>): Percentiles {
+  const sorted = Array.from(values).sort((a, b) => a - b);
+  const at = (p: number) => (sorted.length === 0 ? 0 : sorted[Math.min(sorted.length - 1, Math.ceil(p * sorted.length) - 1)]);
+  return { p50: at(0.5), p95: at(0.95), p99: at(0.99), samples: sorted.length };
+}
+
+/**
+ * Records the main-thread time of one rendered frame, in ms, and the
+ * renderer counters after it
+ * Frames are timed from their first frame callback to the end of rendering
+ * (see PerfProbe in components/RoomViewer.tsx), not from one frame to the
+ * next, so the demand loop idling between frames never counts while a
+ * frame that really is slow always does.
+ */
+export function recordFrame(ms: number, info: WebGLInfo) {
+  renderer.drawCalls = info.render.calls;
+  renderer.triangles = info.render.triangles;
+  renderer.geometries = info.memory.geometries;
+  renderer.textures = info.memory.textures;
+
+  if (ms < 0) return;
+  frameTimes[frameCount % FRAME_SAMPLES] = ms;
+  frameCount++;
+
+  if (frameCount % FRAME_MARK_INTERVAL === 0 && hasUserTiming()) {
+    performance.mark(`${MARK_PREFIX}:frames`, { detail: { ...frameStats(), ...renderer } });
+  }
+}
+
+function frameStats(): Percentiles {
+  return percentiles(frameTimes.subarray(0, Math.min(frameCount, FRAME_SAMPLES)));
+}
+
+/**
+ * Records the stages of one retrieval, with `startTime` from performance.now()
+ * Server stages are only known as durations, so their measures run back to
+ * back from the start; layout is the client's last step and ends at `total`
+ */
+export function recordRetrieval(timings: RetrievalTimings, startTime: number, total: number) {
+  const sample: RetrievalSample = { ...timings, total, timestamp: Date.now() };
+  retrievals.push(sample);
+  if (retrievals.length > RETRIEVAL_HISTORY) retrievals.shift();
+  unsentRetrievals.push(sample);
+  if (unsentRetrievals.length > RETRIEVAL_HISTORY) unsentRetrievals.shift();
+
+  if (!hasUserTiming()) return;
+  let offset = startTime;
+  RETRIEVAL_STAGES.forEach(stage => {
+    const duration = timings[stage];
+    if (duration === undefined) return;
+    const start = stage === 'layout' ? startTime + total - duration : offset;
+    performance.measure(`${MARK_PREFIX}:retrieval:${stage}`, { start, duration });
+    offset += duration;
+  });
+  performance.measure(`${MARK_PREFIX}:retrieval`, { start: startTime, duration: total });
+}
+
+/**
+ * Current metrics; cheap enough to poll a few times a second
+ */
+export function getPerfSnapshot(): PerfSnapshot {
+  const stageP95 = (stage: RetrievalStage | 'total') =>
+    percentiles(retrievals.flatMap(sample => (sample[stage] === undefined ? [] : [sample[stage]!]))).p95;
+  return {
+    frames: frameStats(),
+    renderer: { ...renderer },
+    lastRetrieval: retrievals[retrievals.length - 1] ?? null,
+    retrievalP95: {
+      classify: stageP95('classify'),
+      search: stageP95('search'),
+      rank: stageP95('rank'),
+      layout: stageP95('layout'),
+      total: stageP95('total'),
+    },
+  };
+}
+
+/**
+ * Body posted to the metrics endpoint
+ */
+export interface MetricsReport {
+  frames: Percentiles;
+  renderer: RendererStats;
+  retrievals: RetrievalSample[];
+}
+
+/**
+ * Sends what was recorded since the last beacon, if an endpoint is set
+ */
+export function flushMetrics() {
+  if (!METRICS_ENDPOINT || typeof navigator === 'undefined' || !navigator.sendBeacon) return;
+  const frames = frameStats();
+  if (frames.samples === 0 && unsentRetrievals.length === 0) return;
+
+  const report: MetricsReport = { frames, renderer: { ...renderer }, retrievals: unsentRetrievals };
+  if (navigator.sendBeacon(METRICS_ENDPOINT, JSON.stringify(report))) unsentRetrievals = [];
+}
+
+/**
+ * Flushes metrics whenever the page is hidden; returns an uninstaller
+ */
+export function installMetricsBeacon(): () => void {
+  if (!METRICS_ENDPOINT || typeof document === 'undefined') return () => undefined;
+  const onHide = () => {
+    if (document.visibilityState === 'hidden') flushMetrics();
+  };
+  document.addEventListener('visibilitychange', onHide);
+  window.addEventListener('pagehide', flushMetrics);
+  return () => {
+    document.removeEventListener('visibilitychange', onHide);
+    window.removeEventListener('pagehide', flushMetrics);
+  };
+}
@@ -0,0 +1,43 @@
+import { mkdirSync, readFileSync, writeFileSync } from 'node:fs';
+import { join } from 'node:path';
+import { EMBEDDING_DIM } from './embedding';
+import { QuantizedIndex, shardVersionWord } from './embeddingShards';
+
+/**
+ * Embedding shards written to disk before `next build` (server only)
+ *
+ * scripts/build-embedding-shards.ts encodes every catalogue shard into
+ * data/embeddings/<shard>.bin. The server reads these instead of embedding
+ * the catalogue on cold start; a shard that is missing, or was built from
+ * an older catalogue, is reported as null and the caller embeds at runtime.
+ */
+
+export const PREBUILT_EMBEDDINGS_DIR = join(process.cwd(), 'data', 'embeddings');
+
+const shardPath = (shard: string) => join(PREBUILT_EMBEDDINGS_DIR, `${shard}.bin`);
+
+/**
+ * The prebuilt shard for `shard`, if it matches `version` and `rows`
+ */
+export function readPrebuiltShard(shard: string, version: string, rows: number): QuantizedIndex | null {
+  let file: Buffer;
+  try {
+    file = readFileSync(shardPath(shard));
+  } catch {
+    return null;
+  }
+  try {
+    // Copy out of Node's shared buffer pool so the views start at offset 0
+    const buffer = file.buffer.slice(file.byteOffset, file.byteOffset + file.byteLength) as ArrayBuffer;
+    const index = new QuantizedIndex(buffer);
+    const fresh = index.version === shardVersionWord(version) && index.size === rows && index.dim === EMBEDDING_DIM;
+    return fresh ? index : null;
+  } catch {
+    return null; // Written by an older format
+  }
+}
+
+export function writePrebuiltShard(shard: string, buffer: ArrayBuffer) {
+  mkdirSync(PREBUILT_EMBEDDINGS_DIR, { recursive: true });
+  writeFileSync(shardPath(shard), new Uint8Array(buffer));
+}
@@ -0,0 +1,122 @@
+import { RAGRetrievalResult } from '@/types/furniture';
+import { LRUCache } from './lruCache';
+import { RetrievalRequest, isAbortError, requestKey } from './retrievalBackend';
+import { whenIdle } from './scheduling';
+
+/**
+ * Speculative retrieval for prompts the user is likely to try next
+ *
+ * Requests are queued and fetched one at a time, each starting only in an
+ * idle period with at least `minIdleMs` to spare. Complete results land in
+ * a small client-side LRU. A session budget caps how many bytes speculation may
+ * download, and nothing is prefetched when the browser asks to save data
+ * or the connection is 2G. Foreground retrievals call `cancel` first, so
+ * they never compete with a prefetch for bandwidth.
+ */
+
+export type PrefetchFetcher = (request: RetrievalRequest, signal: AbortSignal) => Promise<RAGRetrievalResult>;
+
+export interface PrefetcherOptions {
+  maxEntries?: number;
+  ttlMs?: number; // Prefetched results older than this are refetched in the foreground
+  maxSessionBytes?: number; // Download budget for all speculation in this page
+  minIdleMs?: number; // Idle time needed before a prefetch starts
+}
+
+type NetworkInformation = { saveData?: boolean; effectiveType?: string };
+
+/**
+ * Rough transfer size of a result; the NDJSON stream is its JSON plus framing
+ */
+function resultBytes(result: RAGRetrievalResult): number {
+  return JSON.stringify(result.furniture).length;
+}
+
+function onConstrainedNetwork(): boolean {
+  if (typeof navigator === 'undefined') return false;
+  const connection = (navigator as Navigator & { connection?: NetworkInformation }).connection;
+  return Boolean(connection?.saveData) || /(^|-)2g$/.test(connection?.effectiveType ?? '');
+}
+
+export class RetrievalPrefetcher {
+  private readonly cache: LRUCache<string, RAGRetrievalResult>;
+  private readonly maxSessionBytes: number;
+  private readonly minIdleMs: number;
+  private queue: RetrievalRequest[] = [];
+  private cancelIdle: (() => void) | null = null;
+  private inFlight: AbortController | null = null;
+  private spentBytes = 0;
+
+  constructor(private readonly fetcher: PrefetchFetcher, options: PrefetcherOptions = {}) {
+    const { maxEntries = 8, ttlMs = 2 * 60 * 1000, maxSessionBytes = 512 * 1024, minIdleMs = 8 } = options;
+    this.cache = new LRUCache({ maxEntries, ttlMs });
+    this.maxSessionBytes = maxSessionBytes;
+    this.minIdleMs = minIdleMs;
+  }
+
+  /**
+   * Replaces the queue; already-cached requests are skipped
+   */
+  schedule(requests: RetrievalRequest[]) {
+    this.queue = requests.filter(request => !this.cache.has(requestKey(request)));
+    this.pump();
+  }
+
+  /**
+   * The prefetched result for `request`, if there is a fresh one
+   */
+  take(request: RetrievalRequest): RAGRetrievalResult | undefined {
+    return this.cache.get(requestKey(request));
+  }
+
+  /**
+   * Stops speculating; the queue and any prefetch in flight are dropped
+   */
+  cancel() {
+    this.queue = [];
+    this.cancelIdle?.();
+    this.cancelIdle = null;
+    this.inFlight?.abort();
+    this.inFlight = null;
+  }
+
+  private pump() {
+    if (this.inFlight || this.cancelIdle || this.queue.length === 0) return;
+    if (this.spentBytes >= this.maxSessionBytes || onConstrainedNetwork()) {
+      this.queue = [];
+      return;
+    }
+
+    this.cancelIdle = whenIdle(timeRemaining => {
+      this.cancelIdle = null;
+      if (timeRemaining < this.minIdleMs) {
+        this.pump(); // Too busy; wait for a longer idle period
+        return;
+      }
+      const request = this.queue.shift();
+      if (request) this.fetch(request);
+    });
+  }
+
+  private fetch(request: RetrievalRequest) {
+    const controller = new AbortController();
+    this.inFlight = controller;
+
+    this.fetcher(request, controller.signal)
+      .then(result => {
+        this.spentBytes += resultBytes(result);
+        // A search cut short by the latency budget is not worth replaying;
+        // the foreground retrieval runs it again in full
+        if (!result.partial) this.cache.set(requestKey(request), result);
+      })
+      .catch(error => {
+        // Speculation is best-effort; the foreground path retries for real
+        if (!isAbortError(error)) console.warn('Prefetch failed:', error);
+      })
+      .finally(() => {
+        if (this.inFlight !== controller) return;
+        this.inFlight = null;
+        this.pump();
+      });
+  }
+}
@@ -0,0 +1,59 @@
+import { LRUCache } from './lruCache';
+
+/**
+ * Fixed-window request limits for the in-memory API routes
+ *
+ * Each client gets `limit` requests per window, counted from its first
+ * request in that window. Windows live in an LRU cache whose entries
+ * expire with the window, so at most `maxClients` are tracked however many
+ * addresses show up.
+ */
+
+export interface RateLimitOptions {
+  limit: number; // Requests per window
+  windowMs: number;
+  maxClients?: number;
+}
+
+export class RateLimiter {
+  private readonly windows: LRUCache<string, { count: number }>;
+  private readonly limit: number;
+
+  constructor({ limit, windowMs, maxClients = 10_000 }: RateLimitOptions) {
+    this.limit = limit;
+    this.windows = new LRUCache({ maxEntries: maxClients, ttlMs: windowMs });
+  }
+
+  /**
+   * Counts one request from `key`; false once the key is over its limit
+   */
+  allow(key: string): boolean {
+    const window = this.windows.get(key);
+    if (!window) {
+      this.windows.set(key, { count: 1 });
+      return true;
+    }
+    if (window.count >= this.limit) return false;
+    window.count++;
+    return true;
+  }
+}
+
+/**
+ * Best-effort client identity for rate limiting: the first forwarded
+ * address when behind a proxy
+ */
+export function clientKey(request: Request): string {
+  const forwarded = request.headers.get('x-forwarded-for')?.split(',')[0].trim();
+  return forwarded || request.headers.get('x-real-ip') || 'unknown';
+}
+
+/**
+ * 429 response telling the client when to retry
+ */
+export function tooManyRequests(windowMs: number): Response {
+  return Response.json(
+    { error: 'Too many requests' },
+    { status: 429, headers: { 'Retry-After': String(Math.ceil(windowMs / 1000)) } }
+  );
+}
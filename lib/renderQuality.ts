@@ -0,0 +1,87 @@
+import * as THREE from 'three';
+
+/**
+ * Rendering quality tiers
+ *
+ * The starting tier comes from what the GPU reports. Frame time measured
+ * while the camera moves can step it down later, but never up, so a slow
+ * device does not flip between tiers mid-consultation.
+ */
+
+export type QualityTier = 'low' | 'medium' | 'high';
+
+export interface QualitySettings {
+  shadowMapSize: number; // 0 turns shadow casting off
+  furnitureShadows: boolean;
+  pointLight: boolean;
+  maxDpr: number;
+}
+
+export const QUALITY_SETTINGS: Record<QualityTier, QualitySettings> = {
+  low: { shadowMapSize: 0, furnitureShadows: false, pointLight: false, maxDpr: 1 },
+  medium: { shadowMapSize: 1024, furnitureShadows: true, pointLight: true, maxDpr: 1.5 },
+  high: { shadowMapSize: 2048, furnitureShadows: true, pointLight: true, maxDpr: 2 },
+};
+
+const SOFTWARE_RENDERER = /swiftshader|llvmpipe|software|basic render/i;
+const MOBILE_GPU = /mali|adreno|powervr|videocore|apple gpu/i;
+
+/**
+ * Picks a starting tier from the renderer's capabilities
+ */
+export function detectQualityTier(gl: THREE.WebGLRenderer): QualityTier {
+  const context = gl.getContext();
+  const debugInfo = context.getExtension('WEBGL_debug_renderer_info');
+  const renderer = String(
+    context.getParameter(debugInfo ? debugInfo.UNMASKED_RENDERER_WEBGL : context.RENDERER) ?? ''
+  );
+  const { maxTextureSize } = gl.capabilities;
+
+  if (SOFTWARE_RENDERER.test(renderer) || maxTextureSize < 4096) return 'low';
+
+  const nav = typeof navigator === 'undefined' ? undefined : (navigator as Navigator & { deviceMemory?: number });
+  const cores = nav?.hardwareConcurrency ?? 4;
+  const memoryGb = nav?.deviceMemory ?? 4;
+  if (MOBILE_GPU.test(renderer) || cores <= 4 || memoryGb <= 4) return 'medium';
+
+  return maxTextureSize >= 8192 ? 'high' : 'medium';
+}
+
+export function lowerTier(tier: QualityTier): QualityTier {
+  return tier === 'high' ? 'medium' : 'low';
+}
+
+// Frames further apart than this are the demand loop idling, not slow frames
+const MAX_CONTINUOUS_DELTA_S = 0.1;
+const SAMPLE_COUNT = 60;
+const SLOW_FRAME_S = 1 / 30;
+
+/**
+ * Watches frame time during continuous rendering
+ *
+ * With an on-demand frame loop most gaps between frames are idle time, so
+ * only back-to-back frames count. Reports slow once the median of a full
+ * window of samples is below 30 fps, then starts a fresh window.
+ */
+export class FrameTimeMonitor {
+  private samples = new Float32Array(SAMPLE_COUNT);
+  private count = 0;
+
+  /**
+   * Records one frame's delta in seconds; returns true when the device is
+   * consistently too slow for the current tier
+   */
+  record(delta: number): boolean {
+    if (delta <= 0 || delta > MAX_CONTINUOUS_DELTA_S) return false;
+    this.samples[this.count++] = delta;
+    if (this.count < SAMPLE_COUNT) return false;
+
+    this.count = 0;
+    const sorted = this.samples.slice().sort();
+    return sorted[SAMPLE_COUNT >> 1] > SLOW_FRAME_S;
+  }
+
+  reset() {
+    this.count = 0;
+  }
+}
@@ -0,0 +1,74 @@
+import { isAbortError } from './retrievalBackend';
+
+/**
+ * Result of a managed request
+ * `superseded` means a newer request was started before this one settled
+ */
+export type RequestOutcome<T> =
+  | { status: 'fulfilled'; value: T }
+  | { status: 'superseded' };
+
+interface InFlightRequest<T> {
+  promise: Promise<T>;
+  controller: AbortController;
+}
+
+/**
+ * Keeps only the newest request's result
+ *
+ * - Starting a request aborts every in-flight request with a different key
+ * - Requests with the same key share one underlying promise
+ * - Each call gets a sequence number; results for anything but the newest
+ *   call come back as `superseded`, whatever order the promises settle in
+ */
+export class LatestRequestManager<T> {
+  private sequence = 0;
+  private inFlight = new Map<string, InFlightRequest<T>>();
+
+  /**
+   * Runs `task` for `key`, or joins the in-flight task with the same key
+   */
+  async run(key: string, task: (signal: AbortSignal) => Promise<T>): Promise<RequestOutcome<T>> {
+    const ticket = ++this.sequence;
+
+    this.inFlight.forEach((request, otherKey) => {
+      if (otherKey !== key) {
+        request.controller.abort();
+        this.inFlight.delete(otherKey);
+      }
+    });
+
+    const request = this.inFlight.get(key) ?? this.start(key, task);
+
+    try {
+      const value = await request.promise;
+      return ticket === this.sequence ? { status: 'fulfilled', value } : { status: 'superseded' };
+    } catch (error) {
+      if (ticket !== this.sequence || isAbortError(error)) {
+        return { status: 'superseded' };
+      }
+      throw error;
+    }
+  }
+
+  /**
+   * Aborts everything in flight; pending callers resolve as superseded
+   */
+  cancelAll() {
+    this.sequence++;
+    this.inFlight.forEach(request => request.controller.abort());
+    this.inFlight.clear();
+  }
+
+  private start(key: string, task: (signal: AbortSignal) => Promise<T>): InFlightRequest<T> {
+    const controller = new AbortController();
+    const request: InFlightRequest<T> = {
+      controller,
+      promise: task(controller.signal).finally(() => {
+        if (this.inFlight.get(key) === request) this.inFlight.delete(key);
+      }),
+    };
+    this.inFlight.set(key, request);
+    return request;
+  }
+}
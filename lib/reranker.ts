@@ -0,0 +1,181 @@
+import { BinaryCatalogue } from './binaryCatalogue';
+import { tokenize } from './embedding';
+import { SearchHit, VectorIndex } from './vectorIndex';
+import { now } from './retrievalBackend';
+
+/**
+ * Second retrieval stage
+ *
+ * Candidate generation (vector and BM25 search) is cheap per item but
+ * coarse. The re-ranker looks closer, but only at a fixed number of fused
+ * candidates, so its cost stays flat however large the catalogue grows.
+ */
+
+/**
+ * Most candidates the re-ranker scores per query
+ */
+export const RERANK_LIMIT = 200;
+
+// Reciprocal rank fusion constant; damps the influence of the very top ranks
+const RRF_K = 60;
+// Deadline checks are cheap but not free; look at the clock this often
+const CHECK_INTERVAL = 32;
+
+const VECTOR_WEIGHT = 0.5;
+const LEXICAL_WEIGHT = 0.3;
+const NAME_COVERAGE_WEIGHT = 0.2;
+
+// Largest possible query-item similarity: unit text parts plus the
+// confidence prior (at most 0.5, see lib/embedding.ts)
+const MAX_SIMILARITY = 1.5;
+
+/**
+ * A row found by either first-stage index
+ * Scores are NaN for the index that did not return the row
+ */
+export interface Candidate {
+  row: number;
+  vector: number;
+  lexical: number;
+  fused: number; // Reciprocal rank fusion of the two rankings
+}
+
+/**
+ * Fuses two best-first hit lists by reciprocal rank into at most `limit`
+ * candidates, best first
+ * Ranks are on different scales (cosine vs BM25), so only positions are mixed
+ */
+export function fuseCandidates(vectorHits: SearchHit[], lexicalHits: SearchHit[], limit = RERANK_LIMIT): Candidate[] {
+  const byRow = new Map<number, Candidate>();
+  const candidate = (row: number) => {
+    let entry = byRow.get(row);
+    if (!entry) {
+      entry = { row, vector: NaN, lexical: NaN, fused: 0 };
+      byRow.set(row, entry);
+    }
+    return entry;
+  };
+
+  vectorHits.forEach((hit, rank) => {
+    const entry = candidate(hit.id);
+    entry.vector = hit.score;
+    entry.fused += 1 / (RRF_K + rank + 1);
+  });
+  lexicalHits.forEach((hit, rank) => {
+    const entry = candidate(hit.id);
+    entry.lexical = hit.score;
+    entry.fused += 1 / (RRF_K + rank + 1);
+  });
+
+  return Array.from(byRow.values())
+    .sort((a, b) => b.fused - a.fused || a.row - b.row)
+    .slice(0, limit);
+}
+
+/**
+ * Re-ranks fused candidates and returns the top `k`
+ *
+ * Each candidate is scored on its embedding similarity, its BM25 score
+ * relative to the best lexical match, and how many query terms its name
+ * contains. Candidates the vector search missed are scored against their
+ * stored vector in `index`, at the same precision as the vector hits.
+ * When `deadline` passes mid-way, the unscored remainder keeps its fused
+ * order behind the scored candidates.
+ *
+ * `onHit` receives each of the returned hits in rank order as soon as no
+ * unscored candidate can overtake it, so callers can stream the head of
+ * the ranking while the tail is still being scored.
+ */
+export function rerankCandidates(
+  catalogue: BinaryCatalogue,
+  index: VectorIndex,
+  candidates: Candidate[],
+  query: { terms: string[]; embedding: Float32Array },
+  k: number,
+  deadline: number,
+  onHit?: (hit: SearchHit, rank: number) => void
+): { hits: SearchHit[]; complete: boolean } {
+  const terms = new Set(query.terms);
+  const maxLexical = candidates.reduce(
+    (max, c) => (Number.isNaN(c.lexical) ? max : Math.max(max, c.lexical)),
+    0
+  );
+  const lexicalScoreOf = (lexical: number) =>
+    Number.isNaN(lexical) || maxLexical === 0 ? 0 : lexical / maxLexical;
+
+  // bounds[i] is the best score any of candidates[i..] can still reach
+  const maxCoverage = terms.size > 0 ? NAME_COVERAGE_WEIGHT : 0;
+  const bounds = new Float64Array(candidates.length + 1).fill(-Infinity);
+  for (let i = candidates.length - 1; i >= 0; i--) {
+    const { vector, lexical } = candidates[i];
+    const bound =
+      VECTOR_WEIGHT * (Number.isNaN(vector) ? MAX_SIMILARITY : vector) +
+      LEXICAL_WEIGHT * lexicalScoreOf(lexical) +
+      maxCoverage;
+    bounds[i] = Math.max(bounds[i + 1], bound);
+  }
+
+  // Scored hits, best first; the first `emitted` have gone to onHit
+  const scored: SearchHit[] = [];
+  let emitted = 0;
+  let complete = true;
+  for (let i = 0; i < candidates.length; i++) {
+    if (i % CHECK_INTERVAL === 0 && i > 0 && now() >= deadline) {
+      complete = false;
+      break;
+    }
+    const { row, vector, lexical } = candidates[i];
+
+    const similarity = Number.isNaN(vector) ? index.score(row, query.embedding) : vector;
+    const lexicalScore = lexicalScoreOf(lexical);
+
+    let covered = 0;
+    if (terms.size > 0) {
+      new Set(tokenize(catalogue.name(row))).forEach(token => {
+        if (terms.has(token)) covered++;
+      });
+    }
+    const nameCoverage = terms.size > 0 ? covered / terms.size : 0;
+
+    const hit = {
+      id: row,
+      score: VECTOR_WEIGHT * similarity + LEXICAL_WEIGHT * lexicalScore + NAME_COVERAGE_WEIGHT * nameCoverage,
+    };
+    scored.splice(insertionIndex(scored, hit, emitted), 0, hit);
+
+    // A hit strictly above every remaining bound keeps its rank
+    while (onHit && emitted < scored.length && emitted < k && scored[emitted].score > bounds[i + 1]) {
+      onHit(scored[emitted], emitted);
+      emitted++;
+    }
+  }
+
+  const hits = scored.slice(0, k);
+  // Unscored candidates fill any remaining slots in fused order
+  for (let i = scored.length; i < candidates.length && hits.length < k; i++) {
+    hits.push({ id: candidates[i].row, score: candidates[i].fused });
+  }
+  if (onHit) {
+    for (let rank = emitted; rank < hits.length; rank++) onHit(hits[rank], rank);
+  }
+  return { hits, complete };
+}
+
+/**
+ * Position of `hit` in best-first `hits`, searching from `start`
+ * Ties go to the lower row, as in a full sort
+ */
+function insertionIndex(hits: SearchHit[], hit: SearchHit, start: number): number {
+  let low = start;
+  let high = hits.length;
+  while (low < high) {
+    const mid = (low + high) >>> 1;
+    const other = hits[mid];
+    if (other.score > hit.score || (other.score === hit.score && other.id < hit.id)) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return low;
+}
@@ -0,0 +1,220 @@
+import { Furniture, RAGRetrievalResult } from '@/types/furniture';
+import { StyleClassification } from '@/types/chat';
+import { BruteForceIndex, SearchHit, TopK, VectorIndex } from './vectorIndex';
+import { LRUCache } from './lruCache';
+
+/**
+ * Pluggable retrieval backends with per-call latency budgets
+ *
+ * A backend receives a deadline and an AbortSignal. It returns the best
+ * ranked results it has when the deadline passes instead of blocking the
+ * chat turn, and stops early once the caller no longer wants the answer.
+ */
+
+/**
+ * What to retrieve
+ */
+export interface RetrievalRequest {
+  query: string;
+  maxResults: number;
+  categories?: string[]; // Restrict results to these categories
+  classification?: StyleClassification; // Already computed for `query`, skips classifying again
+}
+
+/**
+ * How long a retrieval may take and how to cancel it
+ */
+export interface RetrievalOptions {
+  budgetMs?: number; // Latency budget for this call
+  signal?: AbortSignal;
+  // Called once per result, in rank order, as soon as its rank is final
+  onItem?: (furniture: Furniture, rank: number) => void;
+}
+
+/**
+ * A retrieval implementation (in-process index, remote API, ...)
+ */
+export interface RetrievalBackend {
+  retrieve(request: RetrievalRequest, options?: RetrievalOptions): Promise<RAGRetrievalResult>;
+}
+
+/**
+ * Latency budget used when a caller does not pass one
+ */
+export const DEFAULT_LATENCY_BUDGET_MS = 300;
+
+// Work between yields, so aborts and UI events get a chance to run
+const YIELD_INTERVAL_MS = 8;
+const SCAN_CHUNK = 4096;
+
+/**
+ * Canonical form of a query, for de-duplication and cache keys
+ */
+export function normalizeQuery(query: string): string {
+  return query.trim().toLowerCase().replace(/\s+/g, ' ');
+}
+
+/**
+ * Key identifying a retrieval request
+ * The style is a function of the normalized query, so it needs no key part
+ */
+export function requestKey(request: RetrievalRequest): string {
+  const categories = request.categories ? [...request.categories].sort().join(',') : '';
+  return `${normalizeQuery(request.query)}|${request.maxResults}|${categories}`;
+}
+
+/**
+ * Milliseconds since an arbitrary origin, on both browser and server
+ */
+export function now(): number {
+  return typeof performance !== 'undefined' ? performance.now() : Date.now();
+}
+
+/**
+ * Absolute deadline for a call, in `now()` time
+ */
+export function deadlineFor(options: RetrievalOptions = {}): number {
+  return now() + (options.budgetMs ?? DEFAULT_LATENCY_BUDGET_MS);
+}
+
+/**
+ * Error thrown when a retrieval is cancelled
+ */
+export function createAbortError(): Error {
+  return typeof DOMException !== 'undefined'
+    ? new DOMException('Retrieval aborted', 'AbortError')
+    : Object.assign(new Error('Retrieval aborted'), { name: 'AbortError' });
+}
+
+/**
+ * True for errors produced by an aborted retrieval
+ */
+export function isAbortError(error: unknown): boolean {
+  // DOMException is not an Error subclass in every runtime, so match on name
+  return typeof error === 'object' && error !== null &&
+    (error as { name?: unknown }).name === 'AbortError';
+}
+
+export function throwIfAborted(signal?: AbortSignal) {
+  if (signal?.aborted) throw createAbortError();
+}
+
+/**
+ * Resolves after `ms`, or rejects as soon as `signal` aborts
+ */
+export function sleep(ms: number, signal?: AbortSignal): Promise<void> {
+  return new Promise((resolve, reject) => {
+    if (signal?.aborted) {
+      reject(createAbortError());
+      return;
+    }
+    const onAbort = () => {
+      clearTimeout(timer);
+      reject(createAbortError());
+    };
+    const timer = setTimeout(() => {
+      signal?.removeEventListener('abort', onAbort);
+      resolve();
+    }, Math.max(0, ms));
+    signal?.addEventListener('abort', onAbort, { once: true });
+  });
+}
+
+/**
+ * Gives the event loop a turn without the 4 ms clamp of nested timeouts
+ */
+function yieldToEventLoop(): Promise<void> {
+  if (typeof MessageChannel !== 'undefined') {
+    return new Promise(resolve => {
+      const channel = new MessageChannel();
+      channel.port1.onmessage = () => {
+        channel.port1.close();
+        resolve();
+      };
+      channel.port2.postMessage(null);
+    });
+  }
+  return new Promise(resolve => setTimeout(resolve, 0));
+}
+
+/**
+ * Top-k search that stops at `deadline`
+ *
+ * Exhaustive indexes are scanned in chunks; when time runs out the best hits
+ * seen so far are returned with `complete: false`. Graph indexes answer in
+ * well under a millisecond and are searched in one go.
+ */
+export async function searchWithinDeadline(
+  index: VectorIndex,
+  query: Float32Array,
+  k: number,
+  deadline: number,
+  signal?: AbortSignal
+): Promise<{ hits: SearchHit[]; complete: boolean }> {
+  throwIfAborted(signal);
+
+  if (!(index instanceof BruteForceIndex)) {
+    return { hits: index.search(query, k), complete: true };
+  }
+
+  const top = new TopK(k);
+  let sliceStart = now();
+
+  for (let start = 0; start < index.size; start += SCAN_CHUNK) {
+    index.scanRange(query, top, start, start + SCAN_CHUNK);
+
+    const time = now();
+    if (time >= deadline && start + SCAN_CHUNK < index.size) {
+      return { hits: top.drain(), complete: false };
+    }
+    if (time - sliceStart >= YIELD_INTERVAL_MS) {
+      await yieldToEventLoop();
+      throwIfAborted(signal);
+      sliceStart = now();
+    }
+  }
+
+  return { hits: top.drain(), complete: true };
+}
+
+/**
+ * Wraps a backend with a fixed artificial delay, for demos
+ * The delay never exceeds the call's latency budget and stops on abort
+ */
+export function withSyntheticLatency(backend: RetrievalBackend, latencyMs: number): RetrievalBackend {
+  return {
+    async retrieve(request, options = {}) {
+      const budgetMs = options.budgetMs ?? DEFAULT_LATENCY_BUDGET_MS;
+      const delay = Math.min(latencyMs, budgetMs);
+      await sleep(delay, options.signal);
+      return backend.retrieve(request, { ...options, budgetMs: budgetMs - delay });
+    },
+  };
+}
+
+/**
+ * Wraps a backend with a result cache
+ * Partial (budget-limited) results are returned but never cached
+ */
+export function withResultCache(
+  backend: RetrievalBackend,
+  cache: LRUCache<string, RAGRetrievalResult>,
+  keyFor: (request: RetrievalRequest) => string = requestKey
+): RetrievalBackend {
+  return {
+    async retrieve(request, options = {}) {
+      throwIfAborted(options.signal);
+      const key = keyFor(request);
+      const cached = cache.get(key);
+      // No stage ran for a hit, so the original timings do not apply
+      if (cached) {
+        cached.furniture.forEach((furniture, rank) => options.onItem?.(furniture, rank));
+        return { ...cached, query: request.query, timings: {} };
+      }
+
+      const result = await backend.retrieve(request, options);
+      if (!result.partial) cache.set(key, result);
+      return result;
+    },
+  };
+}
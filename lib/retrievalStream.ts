@@ -0,0 +1,177 @@
+import { Furniture, RAGRetrievalResult, RetrievalTimings } from '@/types/furniture';
+import { RoomStyle } from '@/types/chat';
+import {
+  DEFAULT_LATENCY_BUDGET_MS,
+  RetrievalBackend,
+  RetrievalOptions,
+  RetrievalRequest,
+  createAbortError,
+  throwIfAborted,
+} from './retrievalBackend';
+import { nextFrame } from './scheduling';
+
+/**
+ * NDJSON protocol between the /api/retrieve route and the client
+ *
+ * The route writes one JSON event per line: a `meta` header, one `item`
+ * per ranked result in rank order, written as soon as the re-ranker has
+ * fixed that rank, then `done` (or `error`). Clients can
+ * start placing furniture as soon as the first `item` line arrives.
+ */
+
+export const RETRIEVE_ENDPOINT = '/api/retrieve';
+export const NDJSON_CONTENT_TYPE = 'application/x-ndjson';
+
+export type RetrievalEvent =
+  | { type: 'meta'; query: string; style?: RoomStyle; styleScores?: Record<RoomStyle, number> }
+  | { type: 'item'; rank: number; furniture: Furniture }
+  | { type: 'done'; timestamp: string; partial: boolean; timings?: RetrievalTimings }
+  | { type: 'error'; message: string };
+
+/**
+ * Request body accepted by the /api/retrieve route
+ */
+export interface RetrieveRequestBody extends RetrievalRequest {
+  budgetMs?: number;
+}
+
+const encoder = new TextEncoder();
+
+/**
+ * Serializes one event as an NDJSON line
+ */
+export function encodeRetrievalEvent(event: RetrievalEvent): Uint8Array {
+  return encoder.encode(JSON.stringify(event) + '\n');
+}
+
+/**
+ * Reads NDJSON events from a response body, calling `onEvent` per line
+ */
+export async function readRetrievalEvents(
+  body: ReadableStream<Uint8Array>,
+  onEvent: (event: RetrievalEvent) => void,
+  signal?: AbortSignal
+): Promise<void> {
+  const reader = body.getReader();
+  const decoder = new TextDecoder();
+  let buffered = '';
+
+  const onAbort = () => {
+    reader.cancel().catch(() => undefined);
+  };
+  signal?.addEventListener('abort', onAbort, { once: true });
+
+  try {
+    while (true) {
+      const { done, value } = await reader.read();
+      throwIfAborted(signal);
+      if (done) break;
+
+      buffered += decoder.decode(value, { stream: true });
+      let newline = buffered.indexOf('\n');
+      while (newline !== -1) {
+        const line = buffered.slice(0, newline).trim();
+        buffered = buffered.slice(newline + 1);
+        if (line) onEvent(JSON.parse(line) as RetrievalEvent);
+        newline = buffered.indexOf('\n');
+      }
+    }
+
+    const tail = (buffered + decoder.decode()).trim();
+    if (tail) onEvent(JSON.parse(tail) as RetrievalEvent);
+  } finally {
+    signal?.removeEventListener('abort', onAbort);
+  }
+}
+
+/**
+ * Options for a streamed retrieval
+ */
+export interface StreamRetrievalOptions extends RetrievalOptions {
+  // Called with the results so far, at most once per animation frame
+  onProgress?: (furniture: Furniture[]) => void;
+  // Called with the query's style as soon as the stream header arrives
+  onStyle?: (style: RoomStyle) => void;
+}
+
+/**
+ * Retrieves furniture from the server route, streaming ranked items
+ */
+export async function streamFurniture(
+  request: RetrievalRequest,
+  options: StreamRetrievalOptions = {}
+): Promise<RAGRetrievalResult> {
+  const { signal, onProgress, onStyle, onItem } = options;
+  const body: RetrieveRequestBody = {
+    ...request,
+    budgetMs: options.budgetMs ?? DEFAULT_LATENCY_BUDGET_MS,
+  };
+
+  const response = await fetch(RETRIEVE_ENDPOINT, {
+    method: 'POST',
+    headers: { 'Content-Type': 'application/json', Accept: NDJSON_CONTENT_TYPE },
+    body: JSON.stringify(body),
+    signal,
+  });
+  if (!response.ok || !response.body) {
+    throw new Error(`Retrieval failed with status ${response.status}`);
+  }
+
+  const furniture: Furniture[] = [];
+  let meta = null as Extract<RetrievalEvent, { type: 'meta' }> | null;
+  // Assigned from the event callback, so keep the declared types un-narrowed
+  let result = null as RAGRetrievalResult | null;
+  let cancelFrame = null as (() => void) | null;
+
+  const flushProgress = () => {
+    cancelFrame = null;
+    if (!signal?.aborted) onProgress?.(furniture.filter(Boolean));
+  };
+
+  try {
+    await readRetrievalEvents(
+      response.body,
+      event => {
+        switch (event.type) {
+          case 'meta':
+            meta = event;
+            if (event.style) onStyle?.(event.style);
+            break;
+          case 'item':
+            furniture[event.rank] = event.furniture;
+            onItem?.(event.furniture, event.rank);
+            if (onProgress && !cancelFrame) cancelFrame = nextFrame(flushProgress);
+            break;
+          case 'done':
+            result = {
+              furniture: furniture.filter(Boolean),
+              timestamp: new Date(event.timestamp),
+              query: request.query,
+              partial: event.partial,
+              timings: event.timings,
+              ...(meta?.style && { style: meta.style, styleScores: meta.styleScores }),
+            };
+            break;
+          case 'error':
+            throw new Error(event.message);
+          default:
+            break;
+        }
+      },
+      signal
+    );
+  } finally {
+    cancelFrame?.();
+  }
+
+  if (signal?.aborted) throw createAbortError();
+  if (!result) throw new Error('Retrieval stream ended before completion');
+  return result;
+}
+
+/**
+ * Retrieval backend that calls the server route
+ */
+export const remoteRetrievalBackend: RetrievalBackend = {
+  retrieve: (request, options) => streamFurniture(request, options),
+};
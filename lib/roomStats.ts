@@ -0,0 +1,57 @@
+import { Furniture } from '@/types/furniture';
+import { footprintRect, unionArea } from './spatialIndex';
+
+// Size of the demo room, in metres
+export const ROOM_WIDTH = 10;
+export const ROOM_DEPTH = 8;
+export const ROOM_HEIGHT = 3;
+
+export interface RoomCoverage {
+  totalFootprint: number;
+  coveragePercentage: number;
+  itemCount: number;
+}
+
+/**
+ * Rounds a raw footprint into display statistics
+ * Shared by the one-shot calculation and the store's running totals
+ */
+export function summarizeCoverage(
+  footprint: number,
+  itemCount: number,
+  roomWidth: number,
+  roomDepth: number
+): RoomCoverage {
+  const roomArea = roomWidth * roomDepth;
+  const coveragePercentage = (footprint / roomArea) * 100;
+
+  return {
+    totalFootprint: Math.round(footprint * 100) / 100,
+    coveragePercentage: Math.round(coveragePercentage * 10) / 10,
+    itemCount,
+  };
+}
+
+/**
+ * Floor area taken up by one item
+ */
+export function footprintOf(item: Furniture): number {
+  return item.dimensions.width * item.dimensions.depth;
+}
+
+/**
+ * Calculates room coverage statistics
+ * Useful for understanding space utilization
+ * Overlapping items are counted once: the footprint is the union of their areas
+ */
+export function calculateRoomCoverage(
+  furniture: Furniture[],
+  roomWidth: number,
+  roomDepth: number
+): RoomCoverage {
+  const visibleFurniture = furniture.filter(f => f.visible);
+
+  const totalFootprint = unionArea(visibleFurniture.map(footprintRect));
+
+  return summarizeCoverage(totalFootprint, visibleFurniture.length, roomWidth, roomDepth);
+}
@@ -0,0 +1,265 @@
+import { FloorPlanRoom, Furniture } from '@/types/furniture';
+import { distanceToRoom } from './floorPlan';
+import { isSideways } from './spatialIndex';
+import { layoutFurniture } from './layoutClient';
+import { isAbortError } from './retrievalBackend';
+import { streamFurniture } from './retrievalStream';
+import { ROOM_DEPTH, ROOM_WIDTH } from './roomStats';
+
+/**
+ * Lazy per-room furniture for multi-room floor plans
+ *
+ * Each room starts as a bare shell. When the camera comes within
+ * `loadDistance` of a room it can see, the room's furniture is retrieved,
+ * laid out and shown in full. Rooms that fall out of view, or further than
+ * `unloadDistance`, drop back to a proxy: one packed array of footprint
+ * boxes drawn as a single instanced mesh. At most `maxLoadedRooms` rooms
+ * are loaded at once, nearest first, so memory stays bounded however big
+ * the flat is.
+ *
+ * The snapshot API matches FurnitureStore, for useSyncExternalStore.
+ */
+
+export type RoomDetail = 'proxy' | 'loading' | 'loaded';
+
+/**
+ * Low-detail stand-in for an unloaded room's furniture
+ */
+export interface RoomProxy {
+  count: number;
+  boxes: Float32Array; // x, y, z, width, height, depth per item, in plan coordinates
+}
+
+export interface StreamedRoom {
+  room: FloorPlanRoom;
+  detail: RoomDetail;
+  furniture: Furniture[]; // Empty unless loaded
+  proxy: RoomProxy | null; // From the last load; null until the room has loaded once
+}
+
+export type RoomLoader = (room: FloorPlanRoom, signal: AbortSignal) => Promise<Furniture[]>;
+
+export interface RoomStreamerOptions {
+  loadDistance?: number; // Metres from the camera to the room
+  unloadDistance?: number; // Greater than loadDistance, so rooms do not flicker at the edge
+  maxLoadedRooms?: number;
+  outOfViewMs?: number; // How long a loaded room may stay out of view
+  retryMs?: number; // Wait after a failed load
+}
+
+interface RoomSlot extends StreamedRoom {
+  controller: AbortController | null;
+  lastSeen: number;
+  retryAt: number;
+}
+
+const EMPTY: Furniture[] = [];
+
+/**
+ * Packs furniture into proxy boxes, turned items with width and depth swapped
+ */
+export function buildRoomProxy(furniture: Furniture[]): RoomProxy {
+  const boxes = new Float32Array(furniture.length * 6);
+  furniture.forEach((item, i) => {
+    const { width, height, depth } = item.dimensions;
+    const sideways = isSideways(item.rotationY);
+    boxes.set(
+      [
+        item.position.x,
+        item.position.y,
+        item.position.z,
+        sideways ? depth : width,
+        height,
+        sideways ? width : depth,
+      ],
+      i * 6
+    );
+  });
+  return { count: furniture.length, boxes };
+}
+
+export class RoomStreamer {
+  private slots: RoomSlot[];
+  private snapshot: StreamedRoom[];
+  private listeners = new Set<() => void>();
+  private lastUpdate = -Infinity;
+  private readonly options: Required<RoomStreamerOptions>;
+
+  constructor(rooms: FloorPlanRoom[], private readonly load: RoomLoader, options: RoomStreamerOptions = {}) {
+    this.options = {
+      loadDistance: 10,
+      unloadDistance: 14,
+      maxLoadedRooms: 2,
+      outOfViewMs: 2000,
+      retryMs: 5000,
+      ...options,
+    };
+    this.slots = rooms.map(room => ({
+      room,
+      detail: 'proxy',
+      furniture: EMPTY,
+      proxy: null,
+      controller: null,
+      lastSeen: -Infinity,
+      retryAt: 0,
+    }));
+    this.snapshot = this.buildSnapshot();
+  }
+
+  /**
+   * Subscribes to changes; compatible with useSyncExternalStore
+   */
+  subscribe = (listener: () => void): (() => void) => {
+    this.listeners.add(listener);
+    return () => {
+      this.listeners.delete(listener);
+    };
+  };
+
+  /**
+   * Current rooms; the same array until one of them changes
+   */
+  getSnapshot = (): StreamedRoom[] => this.snapshot;
+
+  /**
+   * Loads and unloads rooms for a camera at (x, z) that can see
+   * `visibleRooms`; cheap enough to call every frame
+   */
+  update(x: number, z: number, visibleRooms: ReadonlySet<string>) {
+    const { loadDistance, unloadDistance, maxLoadedRooms, outOfViewMs } = this.options;
+    const time = performance.now();
+    this.lastUpdate = time;
+
+    const wanted = this.slots
+      .map(slot => {
+        if (visibleRooms.has(slot.room.id)) slot.lastSeen = time;
+        const distance = distanceToRoom(slot.room, x, z);
+        const inView = time - slot.lastSeen <= outOfViewMs;
+        const active = slot.detail !== 'proxy';
+        const keep = inView && distance <= (active ? unloadDistance : loadDistance);
+        return { slot, distance, keep };
+      })
+      .filter(entry => entry.keep)
+      .sort((a, b) => a.distance - b.distance)
+      .slice(0, maxLoadedRooms)
+      .map(entry => entry.slot);
+
+    let changed = false;
+    this.slots.forEach(slot => {
+      if (wanted.includes(slot)) {
+        if (slot.detail === 'proxy' && time >= slot.retryAt) {
+          this.startLoad(slot);
+          changed = true;
+        }
+      } else if (slot.detail !== 'proxy') {
+        this.unload(slot);
+        changed = true;
+      }
+    });
+    if (changed) this.emit();
+  }
+
+  /**
+   * Earliest time at which an update could change a room with the camera
+   * standing still: a loaded room outliving `outOfViewMs` out of view or a
+   * failed load coming up for retry. Null when nothing is waiting. Under a
+   * demand frame loop nothing calls update until the next frame, so the
+   * caller schedules one for this time.
+   */
+  nextUpdateAt(): number | null {
+    const { outOfViewMs } = this.options;
+    const time = performance.now();
+    let next = Infinity;
+    this.slots.forEach(slot => {
+      // Rooms seen by the last update stay loaded until the camera moves
+      if (slot.detail !== 'proxy' && slot.lastSeen < this.lastUpdate) {
+        // Just past the deadline, as update keeps rooms seen exactly outOfViewMs ago
+        next = Math.min(next, slot.lastSeen + outOfViewMs + 1);
+      } else if (slot.detail === 'proxy' && slot.retryAt > time) {
+        next = Math.min(next, slot.retryAt);
+      }
+    });
+    return next === Infinity ? null : next;
+  }
+
+  /**
+   * Cancels loads in flight and drops loaded furniture; later updates load
+   * rooms again
+   */
+  dispose() {
+    this.slots.forEach(slot => this.unload(slot));
+    this.emit();
+  }
+
+  private startLoad(slot: RoomSlot) {
+    const controller = new AbortController();
+    slot.controller = controller;
+    slot.detail = 'loading';
+
+    this.load(slot.room, controller.signal).then(
+      furniture => {
+        if (slot.controller !== controller) return; // Unloaded meanwhile
+        slot.controller = null;
+        slot.detail = 'loaded';
+        slot.furniture = furniture;
+        slot.proxy = buildRoomProxy(furniture);
+        this.emit();
+      },
+      error => {
+        if (slot.controller !== controller) return;
+        if (!isAbortError(error)) console.error(`Error loading ${slot.room.name}:`, error);
+        slot.controller = null;
+        slot.detail = 'proxy';
+        slot.retryAt = performance.now() + this.options.retryMs;
+        this.emit();
+      }
+    );
+  }
+
+  private unload(slot: RoomSlot) {
+    slot.controller?.abort();
+    slot.controller = null;
+    slot.detail = 'proxy';
+    slot.furniture = EMPTY;
+  }
+
+  private buildSnapshot(): StreamedRoom[] {
+    return this.slots.map(({ room, detail, furniture, proxy }) => ({ room, detail, furniture, proxy }));
+  }
+
+  private emit() {
+    this.snapshot = this.buildSnapshot();
+    this.listeners.forEach(listener => listener());
+  }
+}
+
+/**
+ * Retrieves and lays out a room's furniture from its prompt
+ * Preferred positions are scaled from the demo room to this one; ids are
+ * prefixed with the room id so they stay unique across the flat. Falls
+ * back to the cached shards in the browser when the route is unreachable.
+ */
+export async function loadRoomFurniture(room: FloorPlanRoom, signal: AbortSignal): Promise<Furniture[]> {
+  const request = { query: room.query, maxResults: 6 };
+  const result = await streamFurniture(request, { signal }).catch(async error => {
+    if (isAbortError(error)) throw error;
+    const { shardRetrievalBackend } = await import('./shardRetrieval');
+    return shardRetrievalBackend.retrieve(request, { signal });
+  });
+
+  const { width, length } = room.config;
+  const scaled = result.furniture.map(item => ({
+    ...item,
+    id: `${room.id}:${item.id}`,
+    position: {
+      ...item.position,
+      x: (item.position.x * width) / ROOM_WIDTH,
+      z: (item.position.z * length) / ROOM_DEPTH,
+    },
+  }));
+  const placed = await layoutFurniture(scaled, { signal, roomWidth: width, roomDepth: length });
+  return placed.map(item => ({
+    ...item,
+    position: { ...item.position, x: item.position.x + room.origin.x, z: item.position.z + room.origin.z },
+  }));
+}
@@ -0,0 +1,214 @@
+import { useLayoutEffect, useReducer } from 'react';
+import * as THREE from 'three';
+import { PartMaterial, PartShape, createPartGeometry } from './furnitureParts';
+
+interface RegistryEntry<T> {
+  resource: T;
+  refs: number;
+  retained: boolean; // False until the first user retains it
+}
+
+/**
+ * Ref-counted cache for three.js resources that need explicit disposal
+ *
+ * Entries are created on first lookup, retained by each mounted user and
+ * disposed once the last user releases them. Disposal is deferred by one
+ * task so that a release followed by a retain in the same commit (key swap,
+ * StrictMode remount) keeps the entry alive.
+ *
+ * An entry looked up but never retained, say by a concurrent render React
+ * threw away, is dropped at the next flush without being disposed: nothing
+ * has drawn it, so it holds no GPU memory. A render that commits after the
+ * drop hands its resource back to `retain`, which adopts it.
+ */
+export class ResourceRegistry<T extends { dispose(): void }> {
+  private entries = new Map<string, RegistryEntry<T>>();
+  private pending = new Set<string>();
+  private flushScheduled = false;
+
+  /**
+   * Returns the resource for `key`, creating it if needed, without retaining it
+   * A new entry is dropped at the next flush unless retained by then.
+   */
+  get(key: string, create: () => T): T {
+    return this.lookup(key, create).resource;
+  }
+
+  /**
+   * Marks one more user of `key`
+   * `rendered` is the resource the user got from `get`; it becomes the
+   * entry's resource if the entry has been dropped since.
+   */
+  retain(key: string, create: () => T, rendered?: T): T {
+    const entry = this.lookup(key, rendered ? () => rendered : create);
+    entry.refs += 1;
+    entry.retained = true;
+    return entry.resource;
+  }
+
+  /**
+   * Drops one user of `key` and schedules disposal when none are left
+   */
+  release(key: string): void {
+    const entry = this.entries.get(key);
+    if (!entry) return;
+
+    entry.refs = Math.max(0, entry.refs - 1);
+    if (entry.refs === 0) {
+      this.pending.add(key);
+      this.scheduleFlush();
+    }
+  }
+
+  /**
+   * Number of live entries, useful for leak checks
+   */
+  get size(): number {
+    return this.entries.size;
+  }
+
+  private lookup(key: string, create: () => T): RegistryEntry<T> {
+    let entry = this.entries.get(key);
+    if (!entry) {
+      entry = { resource: create(), refs: 0, retained: false };
+      this.entries.set(key, entry);
+      this.pending.add(key);
+      this.scheduleFlush();
+    }
+    return entry;
+  }
+
+  private scheduleFlush() {
+    if (this.flushScheduled) return;
+    this.flushScheduled = true;
+
+    setTimeout(() => {
+      this.flushScheduled = false;
+      this.pending.forEach(key => {
+        const entry = this.entries.get(key);
+        if (entry && entry.refs === 0) {
+          if (entry.retained) entry.resource.dispose();
+          this.entries.delete(key);
+        }
+      });
+      this.pending.clear();
+    }, 0);
+  }
+}
+
+/**
+ * Shared unit geometries, keyed by part shape
+ * Item dimensions are applied as a per-mesh or per-instance scale
+ */
+export const geometryRegistry = new ResourceRegistry<THREE.BufferGeometry>();
+
+/**
+ * Shared materials, keyed by material variant and color
+ */
+export const materialRegistry = new ResourceRegistry<THREE.Material>();
+
+/**
+ * Loaded glTF models, keyed by URL and load
+ * Disposing an entry frees the model's GPU resources
+ */
+export const modelRegistry = new ResourceRegistry<{ dispose(): void }>();
+
+/**
+ * Multiplies the emissive term by the per-instance color so that a shared
+ * material glows in each lamp's own color
+ */
+function tintEmissiveByInstanceColor(shader: THREE.WebGLProgramParametersWithUniforms) {
+  shader.fragmentShader = shader.fragmentShader.replace(
+    '#include <emissivemap_fragment>',
+    [
+      '#include <emissivemap_fragment>',
+      '#ifdef USE_COLOR',
+      '  totalEmissiveRadiance *= vColor.rgb;',
+      '#endif',
+    ].join('\n')
+  );
+}
+
+/**
+ * Creates a material for a part variant
+ * Instanced materials are white so that instance colors come through unchanged
+ */
+function createPartMaterial(variant: PartMaterial, hexColor: string, instanced: boolean): THREE.Material {
+  switch (variant) {
+    case 'emissive': {
+      const material = new THREE.MeshStandardMaterial({
+        color: hexColor,
+        emissive: hexColor,
+        emissiveIntensity: 0.3,
+      });
+      if (instanced) {
+        material.onBeforeCompile = tintEmissiveByInstanceColor;
+        material.customProgramCacheKey = () => 'instanced-emissive-tint';
+      }
+      return material;
+    }
+    case 'translucent':
+      return new THREE.MeshStandardMaterial({ color: hexColor, transparent: true, opacity: 0.9 });
+    case 'standard':
+    default:
+      return new THREE.MeshStandardMaterial({ color: hexColor });
+  }
+}
+
+/**
+ * Retains a resource for the lifetime of the calling component
+ *
+ * Rendering only looks the resource up; the commit retains it and the
+ * cleanup releases it, so a render that never commits holds nothing. If
+ * another render replaced the entry in between, the commit retains that
+ * one and renders again before anything is drawn.
+ */
+function useSharedResource<T extends { dispose(): void }>(
+  registry: ResourceRegistry<T>,
+  key: string,
+  create: () => T
+): T {
+  const [, rerender] = useReducer((count: number) => count + 1, 0);
+  const resource = registry.get(key, create);
+
+  useLayoutEffect(() => {
+    if (registry.retain(key, create, resource) !== resource) rerender();
+    return () => registry.release(key);
+    // `create` is derived from `key`, so the key alone identifies the entry
+  }, [registry, key, resource]);
+
+  return resource;
+}
+
+/**
+ * Keeps a loaded model alive for the lifetime of the calling component
+ * `dispose` runs once the last component using the `key` load unmounts.
+ */
+export function useRetainedModel(key: string, dispose: () => void) {
+  useSharedResource(modelRegistry, key, () => ({ dispose }));
+}
+
+/**
+ * Shared unit geometry for a part shape
+ */
+export function useSharedGeometry(shape: PartShape): THREE.BufferGeometry {
+  return useSharedResource(geometryRegistry, shape, () => createPartGeometry(shape));
+}
+
+/**
+ * Shared material for a part drawn as a regular mesh in `hexColor`
+ */
+export function useSharedMaterial(variant: PartMaterial, hexColor: string): THREE.Material {
+  return useSharedResource(materialRegistry, `${variant}:${hexColor}`, () =>
+    createPartMaterial(variant, hexColor, false)
+  );
+}
+
+/**
+ * Shared material for an instanced part, colored per instance
+ */
+export function useInstancedMaterial(variant: PartMaterial): THREE.Material {
+  return useSharedResource(materialRegistry, `instanced:${variant}`, () =>
+    createPartMaterial(variant, '#ffffff', true)
+  );
+}
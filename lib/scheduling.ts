@@ -0,0 +1,34 @@
+/**
+ * Small scheduling helpers shared by streaming UI code
+ */
+
+/**
+ * Schedules `callback` for the next animation frame, or a ~16 ms timeout
+ * outside the browser; returns a function that cancels it
+ */
+export function nextFrame(callback: () => void): () => void {
+  if (typeof requestAnimationFrame !== 'undefined') {
+    const handle = requestAnimationFrame(callback);
+    return () => cancelAnimationFrame(handle);
+  }
+  const handle = setTimeout(callback, 16);
+  return () => clearTimeout(handle);
+}
+
+// What the timeout fallback assumes is left of an idle period
+const IDLE_FALLBACK_MS = 10;
+
+/**
+ * Schedules `callback` for the browser's next idle period, or a short
+ * timeout where requestIdleCallback is missing (Safari); the callback gets
+ * the milliseconds left in the idle period. Returns a function that
+ * cancels it.
+ */
+export function whenIdle(callback: (timeRemaining: number) => void): () => void {
+  if (typeof requestIdleCallback !== 'undefined') {
+    const handle = requestIdleCallback(deadline => callback(deadline.timeRemaining()));
+    return () => cancelIdleCallback(handle);
+  }
+  const handle = setTimeout(() => callback(IDLE_FALLBACK_MS), 200);
+  return () => clearTimeout(handle);
+}
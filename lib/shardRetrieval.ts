@@ -0,0 +1,131 @@
+import { Furniture } from '@/types/furniture';
+import { BinaryCatalogue } from './binaryCatalogue';
+import { getSyncedShard, getSyncedShardVersion, syncCatalogue } from './catalogueSync';
+import {
+  DEFAULT_SHARD,
+  EMBEDDING_SHARD_ENDPOINT,
+  QuantizedIndex,
+  STYLE_SHARDS,
+  shardVersionWord,
+} from './embeddingShards';
+import {
+  CatalogueIndex,
+  buildCatalogueIndex,
+  categoryRows,
+  collectHits,
+  rowsToFurniture,
+  searchCatalogueIndex,
+} from './hybridSearch';
+import { IdbStore } from './idbCache';
+import { RetrievalBackend, deadlineFor, now, throwIfAborted } from './retrievalBackend';
+import { classifyRoomStyle } from './styleDetection';
+
+/**
+ * In-browser retrieval over prebuilt embedding shards
+ *
+ * Only the shard for the detected style is loaded, the first time a query
+ * needs it: catalogue items come from the IndexedDB copy kept by
+ * lib/catalogueSync.ts, vectors from the prerendered quantized shard. Both
+ * are versioned by the catalogue manifest, so they work offline once seen.
+ */
+
+const embeddingStore = new IdbStore<ArrayBuffer>('embeddings');
+
+// One load per shard version, shared by concurrent queries
+const shardIndexes = new Map<string, Promise<CatalogueIndex>>();
+let catalogueReady: Promise<unknown> | null = null;
+
+async function loadEmbeddings(shard: string, version: string): Promise<QuantizedIndex> {
+  const expected = shardVersionWord(version);
+  const stored = await embeddingStore.get(shard);
+  if (stored) {
+    const index = new QuantizedIndex(stored);
+    if (index.version === expected) return index;
+  }
+
+  const response = await fetch(`${EMBEDDING_SHARD_ENDPOINT}/${encodeURIComponent(shard)}?v=${version}`);
+  if (!response.ok) throw new Error(`Embedding shard "${shard}" failed with status ${response.status}`);
+  const buffer = await response.arrayBuffer();
+  const index = new QuantizedIndex(buffer);
+  if (index.version !== expected) {
+    throw new Error(`Embedding shard "${shard}" does not match catalogue version ${version}`);
+  }
+  await embeddingStore.put(shard, buffer);
+  return index;
+}
+
+/**
+ * Catalogue and indexes for one shard, loading them on first use
+ */
+export async function loadShardIndex(shard: string): Promise<CatalogueIndex> {
+  if (!getSyncedShard(shard)) {
+    catalogueReady ??= syncCatalogue().catch(error => {
+      catalogueReady = null;
+      throw error;
+    });
+    await catalogueReady;
+  }
+  const items = getSyncedShard(shard);
+  const version = getSyncedShardVersion(shard);
+  if (!items || !version) throw new Error(`Catalogue shard "${shard}" is not available`);
+
+  const key = `${shard}@${version}`;
+  let loading = shardIndexes.get(key);
+  if (!loading) {
+    loading = loadEmbeddings(shard, version).then(index =>
+      buildCatalogueIndex(BinaryCatalogue.fromItems(items), index)
+    );
+    loading.catch(() => shardIndexes.delete(key));
+    shardIndexes.set(key, loading);
+  }
+  return loading;
+}
+
+/**
+ * Retrieval backend that runs the hybrid search in the browser
+ * Loading a shard is a one-off cost and is not charged to the query budget
+ */
+export const shardRetrievalBackend: RetrievalBackend = {
+  async retrieve(request, options = {}) {
+    const { query, maxResults, categories } = request;
+
+    if (categories) {
+      const catalogueIndex = await loadShardIndex(DEFAULT_SHARD);
+      throwIfAborted(options.signal);
+      return {
+        furniture: rowsToFurniture(
+          catalogueIndex.catalogue,
+          categoryRows(catalogueIndex, categories),
+          options.onItem
+        ),
+        timestamp: new Date(),
+        query,
+      };
+    }
+
+    const classifyStart = now();
+    const { style, scores } = request.classification ?? classifyRoomStyle(query);
+    const classifyTime = request.classification ? undefined : now() - classifyStart;
+    const catalogueIndex = await loadShardIndex(STYLE_SHARDS[style]);
+    throwIfAborted(options.signal);
+
+    const furniture: Furniture[] = [];
+    const { complete, timings } = await searchCatalogueIndex(
+      catalogueIndex,
+      query,
+      maxResults,
+      deadlineFor(options),
+      options.signal,
+      collectHits(catalogueIndex.catalogue, furniture, options.onItem)
+    );
+    return {
+      furniture,
+      timestamp: new Date(),
+      query,
+      partial: !complete,
+      style,
+      styleScores: scores,
+      timings: { classify: classifyTime, ...timings },
+    };
+  },
+};
@@ -0,0 +1,134 @@
+import { RoomStyle, StyleClassification } from '@/types/chat';
+
+/**
+ * Room style classifier
+ *
+ * Compiles a style lexicon into one Aho-Corasick automaton over characters,
+ * so a query is classified in a single pass however many terms there are.
+ * Terms match anywhere in the lowercased query, like `includes()`, and every
+ * occurrence adds its weight to the term's style. The scores are normalized
+ * into a distribution; the best style wins, with ties going to whichever
+ * style comes first in the lexicon.
+ */
+
+export interface StyleLexiconEntry {
+  style: RoomStyle;
+  terms: string[]; // Lowercase; 'japan' also matches inside 'japanese'
+  weight?: number; // Score per occurrence, default 1
+}
+
+/**
+ * Default lexicon, highest tie-break priority first
+ * Modern is also the fallback when nothing matches
+ */
+export const DEFAULT_STYLE_LEXICON: StyleLexiconEntry[] = [
+  { style: 'japanese', terms: ['japan', 'zen', 'tatami'] },
+  { style: 'minimalist', terms: ['minimal'] },
+  { style: 'scandinavian', terms: ['scandinavian', 'nordic'] },
+  { style: 'industrial', terms: ['industrial'] },
+  { style: 'traditional', terms: ['traditional'] },
+  { style: 'modern', terms: ['modern', 'contemporary'] },
+];
+
+interface AutomatonNode {
+  next: Map<string, number>;
+  fail: number;
+  outputs: number[]; // Terms ending here, including via fail links
+}
+
+export class StyleClassifier {
+  // Styles in tie-break order; term outputs index into this
+  private readonly styles: RoomStyle[] = [];
+  private readonly termStyle: number[] = [];
+  private readonly termWeight: number[] = [];
+  private readonly nodes: AutomatonNode[] = [{ next: new Map(), fail: 0, outputs: [] }];
+  private readonly fallbackIndex: number;
+
+  constructor(lexicon: StyleLexiconEntry[] = DEFAULT_STYLE_LEXICON, fallback: RoomStyle = 'modern') {
+    const styleIndex = (style: RoomStyle) => {
+      let index = this.styles.indexOf(style);
+      if (index === -1) index = this.styles.push(style) - 1;
+      return index;
+    };
+
+    lexicon.forEach(({ style, terms, weight = 1 }) => {
+      const index = styleIndex(style);
+      terms.forEach(term => {
+        if (!term) return;
+        const id = this.termStyle.push(index) - 1;
+        this.termWeight.push(weight);
+        this.insert(term.toLowerCase(), id);
+      });
+    });
+    this.fallbackIndex = styleIndex(fallback);
+    this.linkFailures();
+  }
+
+  /**
+   * Scores every style in one pass over the query
+   */
+  classify(query: string): StyleClassification {
+    const raw = new Array<number>(this.styles.length).fill(0);
+    const text = query.toLowerCase();
+    const nodes = this.nodes;
+
+    let state = 0;
+    for (let i = 0; i < text.length; i++) {
+      const ch = text[i];
+      while (state !== 0 && !nodes[state].next.has(ch)) state = nodes[state].fail;
+      state = nodes[state].next.get(ch) ?? 0;
+      for (const term of nodes[state].outputs) raw[this.termStyle[term]] += this.termWeight[term];
+    }
+
+    let total = 0;
+    let best = this.fallbackIndex;
+    raw.forEach((score, index) => {
+      total += score;
+      if (score > raw[best] || (score === raw[best] && score > 0 && index < best)) best = index;
+    });
+    if (total === 0) {
+      raw[best] = 1;
+      total = 1;
+    }
+
+    const scores = {} as Record<RoomStyle, number>;
+    this.styles.forEach((style, index) => {
+      scores[style] = raw[index] / total;
+    });
+    return { style: this.styles[best], scores };
+  }
+
+  private insert(term: string, id: number) {
+    let state = 0;
+    for (const ch of term) {
+      let next = this.nodes[state].next.get(ch);
+      if (next === undefined) {
+        next = this.nodes.push({ next: new Map(), fail: 0, outputs: [] }) - 1;
+        this.nodes[state].next.set(ch, next);
+      }
+      state = next;
+    }
+    this.nodes[state].outputs.push(id);
+  }
+
+  /**
+   * Breadth-first, so a node's fail target is finished before the node
+   */
+  private linkFailures() {
+    const queue: number[] = [];
+    this.nodes[0].next.forEach(child => queue.push(child));
+
+    for (let head = 0; head < queue.length; head++) {
+      const node = this.nodes[queue[head]];
+      node.next.forEach((child, ch) => {
+        let fail = node.fail;
+        while (fail !== 0 && !this.nodes[fail].next.has(ch)) fail = this.nodes[fail].fail;
+        const target = this.nodes[fail].next.get(ch);
+        const childNode = this.nodes[child];
+        childNode.fail = target !== undefined && target !== child ? target : 0;
+        childNode.outputs.push(...this.nodes[childNode.fail].outputs);
+        queue.push(child);
+      });
+    }
+  }
+}
@@ -0,0 +1,20 @@
+import { RoomStyle, StyleClassification } from '@/types/chat';
+import { StyleClassifier } from './styleClassifier';
+
+// Compiled once; classification is a single pass over the query
+const defaultClassifier = new StyleClassifier();
+
+/**
+ * Scores every room style for a user query
+ * Uses lexicon matching (in real implementation, would use NLP/LLM)
+ */
+export function classifyRoomStyle(query: string): StyleClassification {
+  return defaultClassifier.classify(query);
+}
+
+/**
+ * Detects the most likely room style from a user query
+ */
+export function detectRoomStyle(query: string): RoomStyle {
+  return defaultClassifier.classify(query).style;
+}
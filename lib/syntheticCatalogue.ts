@@ -0,0 +1,100 @@
+import { Dimensions, FurnitureCategory } from '@/types/furniture';
+import type { CatalogueItem } from './catalogueManifest';
+import { CATEGORY_COLORS } from './furnitureColors';
+import { FURNITURE_CATEGORIES } from './furnitureCategories';
+import { ROOM_DEPTH, ROOM_WIDTH } from './roomStats';
+
+/**
+ * Deterministic synthetic catalogues and queries, for benchmarks
+ *
+ * Items look like the hand-written catalogue: realistic sizes per
+ * category, positions inside the room and names drawn from a small
+ * vocabulary, so text search has shared terms to work with. The same seed
+ * always produces the same catalogue.
+ */
+
+const BASE_SIZES: Record<FurnitureCategory, Dimensions> = {
+  sofa: { width: 2.0, height: 0.8, depth: 0.9 },
+  table: { width: 1.2, height: 0.5, depth: 0.7 },
+  chair: { width: 0.5, height: 0.9, depth: 0.5 },
+  bed: { width: 1.6, height: 0.5, depth: 2.0 },
+  cabinet: { width: 1.2, height: 0.8, depth: 0.45 },
+  shelf: { width: 1.0, height: 1.8, depth: 0.3 },
+  lamp: { width: 0.35, height: 1.5, depth: 0.35 },
+  other: { width: 0.6, height: 0.6, depth: 0.6 },
+};
+
+const STYLE_WORDS = ['Modern', 'Japanese', 'Scandinavian', 'Industrial', 'Minimalist', 'Traditional', 'Nordic', 'Zen'];
+const MATERIAL_WORDS = ['Oak', 'Walnut', 'Rattan', 'Steel', 'Linen', 'Leather', 'Bamboo', 'Marble', 'Teak', 'Velvet'];
+const NOUNS: Record<FurnitureCategory, string[]> = {
+  sofa: ['Sofa', 'Loveseat', 'Sectional'],
+  table: ['Coffee Table', 'Dining Table', 'Side Table'],
+  chair: ['Chair', 'Armchair', 'Stool'],
+  bed: ['Bed', 'Futon', 'Daybed'],
+  cabinet: ['TV Console', 'Sideboard', 'Cabinet'],
+  shelf: ['Bookshelf', 'Shelf', 'Display Rack'],
+  lamp: ['Floor Lamp', 'Paper Lantern', 'Table Lamp'],
+  other: ['Rug', 'Planter', 'Cushion'],
+};
+const DESCRIPTION_WORDS = ['compact', 'space-saving', 'storage', 'HDB', 'living room', 'low profile', 'handcrafted', 'cosy'];
+
+/**
+ * Small fast PRNG (mulberry32); returns floats in [0, 1)
+ */
+export function seededRandom(seed: number): () => number {
+  let state = seed >>> 0;
+  return () => {
+    state = (state + 0x6d2b79f5) >>> 0;
+    let t = state;
+    t = Math.imul(t ^ (t >>> 15), t | 1);
+    t ^= t + Math.imul(t ^ (t >>> 7), t | 61);
+    return ((t ^ (t >>> 14)) >>> 0) / 4294967296;
+  };
+}
+
+/**
+ * `count` catalogue items with unique ids
+ */
+export function createSyntheticCatalogue(count: number, seed = 1): CatalogueItem[] {
+  const random = seededRandom(seed);
+  const pick = <T>(values: readonly T[]) => values[Math.floor(random() * values.length)];
+  const vary = (value: number) => Math.round(value * (0.8 + random() * 0.4) * 100) / 100;
+
+  const items: CatalogueItem[] = new Array(count);
+  for (let i = 0; i < count; i++) {
+    const category = pick(FURNITURE_CATEGORIES);
+    const base = BASE_SIZES[category];
+    const dimensions = { width: vary(base.width), height: vary(base.height), depth: vary(base.depth) };
+    const hex = parseInt(CATEGORY_COLORS[category].slice(1), 16);
+    const halfWidth = Math.max(0, ROOM_WIDTH / 2 - dimensions.width / 2);
+    const halfDepth = Math.max(0, ROOM_DEPTH / 2 - dimensions.depth / 2);
+
+    items[i] = {
+      id: `syn-${category}-${i}`,
+      name: `${pick(STYLE_WORDS)} ${pick(MATERIAL_WORDS)} ${pick(NOUNS[category])}`,
+      category,
+      position: {
+        x: Math.round((random() * 2 - 1) * halfWidth * 100) / 100,
+        y: dimensions.height / 2,
+        z: Math.round((random() * 2 - 1) * halfDepth * 100) / 100,
+      },
+      dimensions,
+      color: { r: (hex >> 16) & 0xff, g: (hex >> 8) & 0xff, b: hex & 0xff },
+      confidenceScore: Math.round((0.7 + random() * 0.29) * 100) / 100,
+      description: `${pick(DESCRIPTION_WORDS)} ${pick(MATERIAL_WORDS).toLowerCase()} ${pick(DESCRIPTION_WORDS)}`,
+    };
+  }
+  return items;
+}
+
+/**
+ * `count` chat-style queries over the synthetic vocabulary
+ */
+export function createSyntheticQueries(count: number, seed = 2): string[] {
+  const random = seededRandom(seed);
+  const pick = <T>(values: readonly T[]) => values[Math.floor(random() * values.length)];
+  return Array.from({ length: count }, (_, i) => {
+    const category = pick(FURNITURE_CATEGORIES);
+    return `${pick(STYLE_WORDS)} ${pick(MATERIAL_WORDS).toLowerCase()} ${pick(NOUNS[category]).toLowerCase()} for my room #${i}`;
+  });
+}
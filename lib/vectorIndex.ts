@@ -0,0 +1,475 @@
+/**
+ * In-process vector search over item embeddings
+ *
+ * All vectors live in one contiguous Float32Array pool. Small catalogues are
+ * searched exhaustively; large ones use an HNSW (hierarchical navigable small
+ * world) graph so that query cost grows logarithmically with catalogue size.
+ * Similarity is the dot product, so vectors should be normalised upstream.
+ */
+
+/**
+ * A single search result
+ */
+export interface SearchHit {
+  id: number;
+  score: number;
+}
+
+/**
+ * Common interface for exhaustive and approximate indexes
+ */
+export interface VectorIndex {
+  readonly dim: number;
+  readonly size: number;
+  add(vector: Float32Array): number;
+  search(query: Float32Array, k: number): SearchHit[];
+  score(id: number, query: Float32Array): number; // Similarity at the precision search uses
+}
+
+/**
+ * Catalogue size above which createVectorIndex switches to HNSW
+ */
+export const HNSW_THRESHOLD = 5000;
+
+/**
+ * Dot product of `query` with the vector stored at `offset` in `data`
+ * Four independent accumulators let the JIT pipeline (and vectorise) the loop
+ */
+export function dotAt(data: Float32Array, offset: number, query: Float32Array, dim: number): number {
+  let s0 = 0;
+  let s1 = 0;
+  let s2 = 0;
+  let s3 = 0;
+  let i = 0;
+  for (; i + 3 < dim; i += 4) {
+    s0 += data[offset + i] * query[i];
+    s1 += data[offset + i + 1] * query[i + 1];
+    s2 += data[offset + i + 2] * query[i + 2];
+    s3 += data[offset + i + 3] * query[i + 3];
+  }
+  for (; i < dim; i++) {
+    s0 += data[offset + i] * query[i];
+  }
+  return s0 + s1 + s2 + s3;
+}
+
+/**
+ * Growable, contiguous storage for fixed-width vectors
+ */
+export class EmbeddingPool {
+  readonly dim: number;
+  data: Float32Array;
+  count = 0;
+
+  constructor(dim: number, initialCapacity: number = 64) {
+    this.dim = dim;
+    this.data = new Float32Array(dim * Math.max(1, initialCapacity));
+  }
+
+  get capacity(): number {
+    return this.data.length / this.dim;
+  }
+
+  /**
+   * Copies `vector` into the pool and returns its id
+   */
+  add(vector: Float32Array): number {
+    if (vector.length !== this.dim) {
+      throw new Error(`Expected a ${this.dim}-dimensional vector, got ${vector.length}`);
+    }
+    if (this.count === this.capacity) {
+      const grown = new Float32Array(this.data.length * 2);
+      grown.set(this.data);
+      this.data = grown;
+    }
+    this.data.set(vector, this.count * this.dim);
+    return this.count++;
+  }
+
+  /**
+   * Zero-copy view of a stored vector
+   */
+  vector(id: number): Float32Array {
+    return this.data.subarray(id * this.dim, (id + 1) * this.dim);
+  }
+
+  /**
+   * Similarity between a stored vector and `query`
+   */
+  dot(id: number, query: Float32Array): number {
+    return dotAt(this.data, id * this.dim, query, this.dim);
+  }
+}
+
+/**
+ * Binary heap over (id, score) pairs
+ * A min-heap keeps the best k results; a max-heap orders search candidates
+ */
+class ScoreHeap {
+  private ids: number[] = [];
+  private scores: number[] = [];
+  private readonly sign: number;
+
+  constructor(kind: 'min' | 'max') {
+    this.sign = kind === 'min' ? 1 : -1;
+  }
+
+  get size(): number {
+    return this.ids.length;
+  }
+
+  peekId(): number {
+    return this.ids[0];
+  }
+
+  peekScore(): number {
+    return this.scores[0];
+  }
+
+  push(id: number, score: number) {
+    const { ids, scores } = this;
+    let index = ids.length;
+    ids.push(id);
+    scores.push(score);
+
+    while (index > 0) {
+      const parent = (index - 1) >> 1;
+      if (this.sign * (scores[parent] - score) <= 0) break;
+      ids[index] = ids[parent];
+      scores[index] = scores[parent];
+      index = parent;
+    }
+    ids[index] = id;
+    scores[index] = score;
+  }
+
+  pop(): SearchHit | undefined {
+    const { ids, scores } = this;
+    if (ids.length === 0) return undefined;
+
+    const top = { id: ids[0], score: scores[0] };
+    const lastId = ids.pop()!;
+    const lastScore = scores.pop()!;
+    const length = ids.length;
+    if (length === 0) return top;
+
+    let index = 0;
+    while (true) {
+      const left = index * 2 + 1;
+      if (left >= length) break;
+      const right = left + 1;
+      const child =
+        right < length && this.sign * (scores[right] - scores[left]) < 0 ? right : left;
+      if (this.sign * (scores[child] - lastScore) >= 0) break;
+      ids[index] = ids[child];
+      scores[index] = scores[child];
+      index = child;
+    }
+    ids[index] = lastId;
+    scores[index] = lastScore;
+    return top;
+  }
+
+  /**
+   * Drains the heap into hits ordered best-first
+   */
+  drainDescending(): SearchHit[] {
+    const hits: SearchHit[] = [];
+    let hit = this.pop();
+    while (hit) {
+      hits.push(hit);
+      hit = this.pop();
+    }
+    return this.sign === 1 ? hits.reverse() : hits;
+  }
+}
+
+/**
+ * Bounded collector that keeps the k highest-scoring ids
+ */
+export class TopK {
+  private heap = new ScoreHeap('min');
+  readonly k: number;
+
+  constructor(k: number) {
+    this.k = k;
+  }
+
+  get size(): number {
+    return this.heap.size;
+  }
+
+  /**
+   * Lowest score still in the top k, or -Infinity while not full
+   */
+  get threshold(): number {
+    return this.heap.size < this.k ? -Infinity : this.heap.peekScore();
+  }
+
+  offer(id: number, score: number) {
+    if (this.k <= 0) return;
+    if (this.heap.size < this.k) {
+      this.heap.push(id, score);
+    } else if (score > this.heap.peekScore()) {
+      this.heap.pop();
+      this.heap.push(id, score);
+    }
+  }
+
+  /**
+   * Results ordered best-first; empties the collector
+   */
+  drain(): SearchHit[] {
+    return this.heap.drainDescending();
+  }
+}
+
+/**
+ * Exhaustive index: one pass over the pool per query
+ */
+export class BruteForceIndex implements VectorIndex {
+  readonly pool: EmbeddingPool;
+
+  constructor(dim: number, initialCapacity?: number) {
+    this.pool = new EmbeddingPool(dim, initialCapacity);
+  }
+
+  get dim(): number {
+    return this.pool.dim;
+  }
+
+  get size(): number {
+    return this.pool.count;
+  }
+
+  add(vector: Float32Array): number {
+    return this.pool.add(vector);
+  }
+
+  search(query: Float32Array, k: number): SearchHit[] {
+    const top = new TopK(k);
+    this.scanRange(query, top, 0, this.pool.count);
+    return top.drain();
+  }
+
+  score(id: number, query: Float32Array): number {
+    return this.pool.dot(id, query);
+  }
+
+  /**
+   * Scores ids in [start, end) into `top`, so callers can scan in slices
+   */
+  scanRange(query: Float32Array, top: TopK, start: number, end: number) {
+    const { data, dim, count } = this.pool;
+    const stop = Math.min(end, count);
+    for (let id = start, offset = start * dim; id < stop; id++, offset += dim) {
+      top.offer(id, dotAt(data, offset, query, dim));
+    }
+  }
+}
+
+/**
+ * Tuning parameters for the HNSW graph
+ */
+export interface HnswOptions {
+  m?: number; // Neighbours per node on upper layers (layer 0 keeps 2m)
+  efConstruction?: number; // Beam width while inserting
+  efSearch?: number; // Beam width while querying (raised to k if smaller)
+  seed?: number; // Seed for level assignment, for reproducible graphs
+}
+
+const MAX_LEVEL = 16;
+
+/**
+ * Approximate nearest-neighbour index (Malkov & Yashunin, 2016)
+ */
+export class HnswIndex implements VectorIndex {
+  readonly pool: EmbeddingPool;
+  readonly m: number;
+  readonly efConstruction: number;
+  efSearch: number;
+
+  // links[node][level] holds the node's neighbour ids on that layer
+  private links: number[][][] = [];
+  private entryPoint = -1;
+  private maxLevel = -1;
+  private readonly levelScale: number;
+  private rngState: number;
+
+  // Visited marks are epoch-stamped so they never need clearing
+  private visited = new Uint32Array(0);
+  private epoch = 0;
+
+  constructor(dim: number, options: HnswOptions = {}) {
+    this.pool = new EmbeddingPool(dim);
+    this.m = options.m ?? 16;
+    this.efConstruction = options.efConstruction ?? 100;
+    this.efSearch = options.efSearch ?? 64;
+    this.levelScale = 1 / Math.log(this.m);
+    this.rngState = (options.seed ?? 0x9e3779b9) >>> 0;
+  }
+
+  get dim(): number {
+    return this.pool.dim;
+  }
+
+  get size(): number {
+    return this.pool.count;
+  }
+
+  add(vector: Float32Array): number {
+    const id = this.pool.add(vector);
+    const level = this.randomLevel();
+    const nodeLinks: number[][] = [];
+    for (let l = 0; l <= level; l++) nodeLinks.push([]);
+    this.links.push(nodeLinks);
+
+    if (this.entryPoint === -1) {
+      this.entryPoint = id;
+      this.maxLevel = level;
+      return id;
+    }
+
+    const query = this.pool.vector(id);
+    let entry = this.entryPoint;
+
+    // Greedy descent through layers above the new node's level
+    for (let l = this.maxLevel; l > level; l--) {
+      entry = this.greedyClosest(query, entry, l);
+    }
+
+    for (let l = Math.min(level, this.maxLevel); l >= 0; l--) {
+      const candidates = this.searchLayer(query, entry, this.efConstruction, l);
+      const maxLinks = l === 0 ? this.m * 2 : this.m;
+      const neighbours = candidates.slice(0, this.m);
+
+      nodeLinks[l] = neighbours.map(hit => hit.id);
+      neighbours.forEach(hit => this.connect(hit.id, id, l, maxLinks));
+      entry = candidates[0].id;
+    }
+
+    if (level > this.maxLevel) {
+      this.entryPoint = id;
+      this.maxLevel = level;
+    }
+    return id;
+  }
+
+  search(query: Float32Array, k: number): SearchHit[] {
+    if (this.entryPoint === -1 || k <= 0) return [];
+
+    let entry = this.entryPoint;
+    for (let l = this.maxLevel; l > 0; l--) {
+      entry = this.greedyClosest(query, entry, l);
+    }
+    return this.searchLayer(query, entry, Math.max(this.efSearch, k), 0).slice(0, k);
+  }
+
+  score(id: number, query: Float32Array): number {
+    return this.pool.dot(id, query);
+  }
+
+  /**
+   * Level for a new node, drawn from an exponentially decaying distribution
+   */
+  private randomLevel(): number {
+    // xorshift32
+    let x = this.rngState;
+    x ^= x << 13;
+    x ^= x >>> 17;
+    x ^= x << 5;
+    this.rngState = x >>> 0;
+    const uniform = (this.rngState + 1) / 4294967297;
+    return Math.min(MAX_LEVEL, Math.floor(-Math.log(uniform) * this.levelScale));
+  }
+
+  /**
+   * Adds `target` to `node`'s neighbour list, pruning to the best `maxLinks`
+   */
+  private connect(node: number, target: number, level: number, maxLinks: number) {
+    const neighbours = this.links[node][level];
+    neighbours.push(target);
+    if (neighbours.length <= maxLinks) return;
+
+    const base = this.pool.vector(node);
+    const top = new TopK(maxLinks);
+    neighbours.forEach(id => top.offer(id, this.pool.dot(id, base)));
+    this.links[node][level] = top.drain().map(hit => hit.id);
+  }
+
+  private greedyClosest(query: Float32Array, start: number, level: number): number {
+    let current = start;
+    let currentScore = this.pool.dot(current, query);
+    let improved = true;
+
+    while (improved) {
+      improved = false;
+      const neighbours = this.links[current][level];
+      for (let i = 0; i < neighbours.length; i++) {
+        const score = this.pool.dot(neighbours[i], query);
+        if (score > currentScore) {
+          currentScore = score;
+          current = neighbours[i];
+          improved = true;
+        }
+      }
+    }
+    return current;
+  }
+
+  private nextEpoch(): number {
+    if (this.visited.length < this.pool.count) {
+      this.visited = new Uint32Array(this.pool.capacity);
+      this.epoch = 0;
+    }
+    this.epoch = (this.epoch + 1) >>> 0;
+    if (this.epoch === 0) {
+      this.visited.fill(0);
+      this.epoch = 1;
+    }
+    return this.epoch;
+  }
+
+  /**
+   * Beam search on one layer; returns up to `ef` hits ordered best-first
+   */
+  private searchLayer(query: Float32Array, entry: number, ef: number, level: number): SearchHit[] {
+    const epoch = this.nextEpoch();
+    const visited = this.visited;
+    const candidates = new ScoreHeap('max');
+    const results = new TopK(ef);
+
+    const entryScore = this.pool.dot(entry, query);
+    visited[entry] = epoch;
+    candidates.push(entry, entryScore);
+    results.offer(entry, entryScore);
+
+    while (candidates.size > 0) {
+      if (candidates.peekScore() < results.threshold) break;
+      const current = candidates.pop()!.id;
+      const neighbours = this.links[current][level];
+
+      for (let i = 0; i < neighbours.length; i++) {
+        const neighbour = neighbours[i];
+        if (visited[neighbour] === epoch) continue;
+        visited[neighbour] = epoch;
+
+        const score = this.pool.dot(neighbour, query);
+        if (score > results.threshold) {
+          candidates.push(neighbour, score);
+          results.offer(neighbour, score);
+        }
+      }
+    }
+    return results.drain();
+  }
+}
+
+/**
+ * Picks an exhaustive or graph index based on the expected catalogue size
+ */
+export function createVectorIndex(dim: number, expectedSize: number): VectorIndex {
+  return expectedSize >= HNSW_THRESHOLD
+    ? new HnswIndex(dim)
+    : new BruteForceIndex(dim, expectedSize);
+}
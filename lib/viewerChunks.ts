@@ -0,0 +1,34 @@
+/**
+ * Chunk loaders for the 3D viewer
+ *
+ * The viewer's first paint needs only the canvas, lights, room shell and
+ * furniture. Controls, the floor grid, shadows and glTF models are separate
+ * chunks that load after it. Prefetching starts them all early, e.g. while
+ * the user is still typing a prompt, so they are cached by the time the
+ * viewer mounts.
+ */
+
+export const loadRoomViewer = () => import('@/components/RoomViewer');
+export const loadSceneControls = () => import('@/components/SceneControls');
+export const loadRoomGrid = () => import('@/components/RoomGrid');
+export const loadSceneShadows = () => import('@/components/SceneShadows');
+export const loadFurnitureModel = () => import('@/components/FurnitureModel');
+
+let prefetch: Promise<unknown> | null = null;
+
+/**
+ * Starts downloading every viewer chunk; safe to call repeatedly
+ */
+export function prefetchViewerChunks() {
+  if (prefetch) return;
+  prefetch = Promise.all([
+    loadRoomViewer(),
+    loadSceneControls(),
+    loadRoomGrid(),
+    loadSceneShadows(),
+    loadFurnitureModel(),
+  ]).catch(() => {
+    // Let a later call retry; the viewer loads them itself regardless
+    prefetch = null;
+  });
+}
@@ -0,0 +1,105 @@
+/**
+ * DecoPlan service worker
+ *
+ * - Hashed build assets are immutable: cache first
+ * - Model binaries are cache first in their own cache; their paths are not
+ *   hashed, so bump MODEL_CACHE_VERSION whenever models under /public change
+ * - Draco decoders from gstatic are versioned by path: cache first
+ * - Catalogue entry requests carry the manifest version: cache first
+ * - Embedding shards carry their catalogue shard version: cache first
+ * - The catalogue manifest is network first, falling back to the cached
+ *   copy offline; IndexedDB (lib/catalogueSync.ts) holds the entries
+ *
+ * Bump CACHE_VERSION to drop every cache from an older worker. On activate,
+ * any decoplan- cache not named below is deleted, so a version bump also
+ * frees the space the old models took.
+ */
+
+const CACHE_VERSION = 'v1';
+const MODEL_CACHE_VERSION = 'm1';
+const ASSET_CACHE = `decoplan-assets-${CACHE_VERSION}`;
+const MODEL_CACHE = `decoplan-models-${CACHE_VERSION}-${MODEL_CACHE_VERSION}`;
+const CATALOGUE_CACHE = `decoplan-catalogue-${CACHE_VERSION}`;
+const KNOWN_CACHES = [ASSET_CACHE, MODEL_CACHE, CATALOGUE_CACHE];
+
+const MODEL_EXTENSIONS = /\.(glb|gltf|bin|ktx2|drc)$/i;
+const DRACO_DECODER_PREFIX = 'https://www.gstatic.com/draco/';
+
+self.addEventListener('install', () => {
+  self.skipWaiting();
+});
+
+self.addEventListener('activate', event => {
+  event.waitUntil(
+    caches
+      .keys()
+      .then(names =>
+        Promise.all(
+          names
+            .filter(name => name.startsWith('decoplan-') && !KNOWN_CACHES.includes(name))
+            .map(name => caches.delete(name))
+        )
+      )
+      .then(() => self.clients.claim())
+  );
+});
+
+async function cacheFirst(request, cacheName) {
+  const cache = await caches.open(cacheName);
+  const cached = await cache.match(request);
+  if (cached) return cached;
+
+  const response = await fetch(request);
+  // Opaque cross-origin responses cannot be checked, so only keep real successes
+  if (response.ok) cache.put(request, response.clone());
+  return response;
+}
+
+async function networkFirst(request, cacheName) {
+  const cache = await caches.open(cacheName);
+  try {
+    const response = await fetch(request);
+    if (response.ok) cache.put(request, response.clone());
+    return response;
+  } catch (error) {
+    const cached = await cache.match(request);
+    if (cached) return cached;
+    throw error;
+  }
+}
+
+self.addEventListener('fetch', event => {
+  const { request } = event;
+  if (request.method !== 'GET') return;
+
+  const url = new URL(request.url);
+
+  if (url.href.startsWith(DRACO_DECODER_PREFIX)) {
+    event.respondWith(cacheFirst(request, ASSET_CACHE));
+    return;
+  }
+  if (url.origin !== self.location.origin) return;
+
+  if (url.pathname.startsWith('/_next/static/')) {
+    event.respondWith(cacheFirst(request, ASSET_CACHE));
+    return;
+  }
+
+  if (MODEL_EXTENSIONS.test(url.pathname)) {
+    event.respondWith(cacheFirst(request, MODEL_CACHE));
+    return;
+  }
+
+  if (url.pathname.startsWith('/api/embeddings/') && url.searchParams.has('v')) {
+    event.respondWith(cacheFirst(request, CATALOGUE_CACHE));
+    return;
+  }
+
+  if (url.pathname === '/api/catalogue') {
+    event.respondWith(
+      url.searchParams.has('v')
+        ? cacheFirst(request, CATALOGUE_CACHE)
+        : networkFirst(request, CATALOGUE_CACHE)
+    );
+  }
+});
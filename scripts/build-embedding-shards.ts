@@ -0,0 +1,17 @@
+/**
+ * Encodes every catalogue shard's embeddings into data/embeddings
+ * Runs before `next build`; see lib/prebuiltEmbeddings.ts
+ *
+ *   node --import ./bench/register.mjs scripts/build-embedding-shards.ts
+ */
+import { BinaryCatalogue } from '@/lib/binaryCatalogue';
+import { CATALOGUE_SHARDS, getCatalogueManifest } from '@/lib/catalogueManifest';
+import { encodeEmbeddingShard } from '@/lib/embeddingShards';
+import { PREBUILT_EMBEDDINGS_DIR, writePrebuiltShard } from '@/lib/prebuiltEmbeddings';
+
+for (const { shard, version } of getCatalogueManifest().shards) {
+  const catalogue = BinaryCatalogue.fromItems(CATALOGUE_SHARDS[shard]);
+  writePrebuiltShard(shard, encodeEmbeddingShard(catalogue, version));
+  console.log(`${shard}: ${catalogue.count} rows, version ${version}`);
+}
+console.log(`Embedding shards written to ${PREBUILT_EMBEDDINGS_DIR}`);
@@ -0,0 +1,67 @@
+#!/usr/bin/env node
+/**
+ * Bundle-size budget for the client build
+ *
+ * Runs after `next build`. Gzips every client chunk, finds the chunks each
+ * budget entry names by a string that survives minification, and exits
+ * non-zero when one of them, or the client total, is over budget.
+ *
+ *   node scripts/check-bundle-size.mjs [path/to/bundle-budget.json]
+ */
+import { readFileSync, readdirSync, statSync } from 'node:fs';
+import { join, relative, resolve } from 'node:path';
+import { gzipSync } from 'node:zlib';
+
+const root = process.cwd();
+const budgetPath = resolve(root, process.argv[2] ?? 'bundle-budget.json');
+const budget = JSON.parse(readFileSync(budgetPath, 'utf8'));
+const chunksDir = resolve(root, budget.chunksDir);
+
+function listChunks(dir) {
+  return readdirSync(dir).flatMap(name => {
+    const path = join(dir, name);
+    if (statSync(path).isDirectory()) return listChunks(path);
+    return name.endsWith('.js') ? [path] : [];
+  });
+}
+
+let files;
+try {
+  files = listChunks(chunksDir);
+} catch {
+  console.error(`Bundle budget: no build output at ${relative(root, chunksDir)}; run next build first`);
+  process.exit(1);
+}
+
+const chunks = files.map(path => {
+  const source = readFileSync(path);
+  return { path: relative(root, path), source: source.toString('utf8'), gzip: gzipSync(source, { level: 9 }).length };
+});
+
+const kb = bytes => (bytes / 1024).toFixed(1);
+let failed = false;
+
+for (const entry of budget.chunks) {
+  const matches = chunks.filter(chunk => chunk.source.includes(entry.marker));
+  if (matches.length === 0) {
+    console.error(`✗ ${entry.name}: no chunk contains "${entry.marker}"`);
+    failed = true;
+    continue;
+  }
+  // A chunk the marker lands in can still be split further by the bundler
+  const size = matches.reduce((total, chunk) => total + chunk.gzip, 0);
+  const over = size > entry.maxGzipKb * 1024;
+  if (over) failed = true;
+  console.log(`${over ? '✗' : '✓'} ${entry.name}: ${kb(size)} kB gzip (budget ${entry.maxGzipKb} kB)`);
+  if (over) matches.forEach(chunk => console.log(`    ${chunk.path}  ${kb(chunk.gzip)} kB`));
+}
+
+const total = chunks.reduce((sum, chunk) => sum + chunk.gzip, 0);
+const totalOver = total > budget.totalMaxGzipKb * 1024;
+if (totalOver) failed = true;
+console.log(`${totalOver ? '✗' : '✓'} total: ${kb(total)} kB gzip (budget ${budget.totalMaxGzipKb} kB)`);
+
+if (failed) {
+  console.error('Bundle budget exceeded; see bundle-budget.json');
+  process.exit(1);
+}
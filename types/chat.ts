@@ -9,6 +9,7 @@ export interface ChatMessage {
   role: MessageRole;
   content: string;
   timestamp: Date;
+  streaming?: boolean; // True while content is still being appended
 }
 
 export type RoomStyle =
@@ -19,6 +20,14 @@ export type RoomStyle =
   | 'industrial'
   | 'traditional';
 
+/**
+ * Style scores for a query, normalized to sum to 1
+ */
+export interface StyleClassification {
+  style: RoomStyle; // Highest scoring style
+  scores: Record<RoomStyle, number>;
+}
+
 export interface StyleQuery {
   style: RoomStyle;
   query: string;
@@ -1,3 +1,5 @@
+import { RoomStyle } from './chat';
+
 /**
  * Represents a 3D position in space
  */
@@ -38,6 +40,14 @@ export type FurnitureCategory =
   | 'lamp'
   | 'other';
 
+/**
+ * One level of detail of a furniture model
+ */
+export interface ModelLod {
+  url: string; // Compressed glTF (.glb, Draco or Meshopt)
+  distance: number; // Camera distance from which this level is used
+}
+
 /**
  * Main furniture interface representing a furniture item retrieved by RAG
  */
@@ -46,11 +56,14 @@ export interface Furniture {
   name: string;
   category: FurnitureCategory;
   position: Position;
+  rotationY?: number; // Turn about the vertical axis in radians, a multiple of π/2; unset is 0
   dimensions: Dimensions;
   color: Color;
   confidenceScore: number; // RAG retrieval confidence score (0-1)
   visible: boolean; // Toggle visibility in the 3D scene
   description?: string;
+  modelUrl?: string; // Full-detail glTF model; primitives are drawn without one
+  modelLods?: ModelLod[]; // Lower-detail models for greater distances
 }
 
 /**
@@ -64,6 +77,46 @@ export interface RoomConfig {
   floorColor: Color;
 }
 
+/**
+ * One room of a floor plan, placed by the centre of its floor
+ */
+export interface FloorPlanRoom {
+  id: string;
+  name: string;
+  origin: { x: number; z: number };
+  config: RoomConfig;
+  query: string; // Retrieval prompt for the room's furniture
+}
+
+/**
+ * Door between two rooms, centred on their shared wall
+ */
+export interface Doorway {
+  rooms: [string, string];
+  x: number;
+  z: number;
+  width: number;
+}
+
+/**
+ * Multi-room flat; the first room is the one the chat designs
+ */
+export interface FloorPlan {
+  rooms: FloorPlanRoom[];
+  doorways: Doorway[];
+}
+
+/**
+ * Milliseconds spent in each retrieval stage; stages that did not run
+ * (e.g. on a cache hit) are absent
+ */
+export interface RetrievalTimings {
+  classify?: number; // Room style classification
+  search?: number; // Vector and BM25 candidate generation
+  rank?: number; // Fusion and re-ranking
+  layout?: number; // Placing the results in the room (client side)
+}
+
 /**
  * RAG retrieval result interface
  */
@@ -71,4 +124,8 @@ export interface RAGRetrievalResult {
   furniture: Furniture[];
   timestamp: Date;
   query?: string;
+  partial?: boolean; // True when the latency budget ran out before the search finished
+  style?: RoomStyle; // Style the query was classified as; absent for category retrievals
+  styleScores?: Record<RoomStyle, number>;
+  timings?: RetrievalTimings;
 }